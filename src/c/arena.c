@@ -0,0 +1,34 @@
+#include "arena.h"
+
+static uint32_t s_buffer[(ARENA_SIZE + 3) / 4];
+static size_t s_used = 0;
+static size_t s_peak = 0;
+
+void *arena_alloc(size_t size) {
+  size = (size + 3) & ~(size_t)3;
+  if (s_used + size > sizeof(s_buffer)) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Arena full, %d of %d bytes used, %d requested",
+            (int)s_used, (int)sizeof(s_buffer), (int)size);
+    return NULL;
+  }
+  void *block = (uint8_t *)s_buffer + s_used;
+  s_used += size;
+  if (s_used > s_peak) {
+    s_peak = s_used;
+  }
+  return block;
+}
+
+void arena_reset() {
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Arena released, %d of %d bytes used",
+          (int)s_used, (int)sizeof(s_buffer));
+  s_used = 0;
+}
+
+size_t arena_used() {
+  return s_used;
+}
+
+size_t arena_peak() {
+  return s_peak;
+}
@@ -0,0 +1,36 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Largest PDC image, the file without its 8 byte header (heavy_snow: 366
+// byte file, 358 byte image), rounded up to keep the blocks aligned.
+// tests/test_arena.c checks that every icon resource fits.
+#define ARENA_ICON_SIZE 360
+
+// Per window: the icons of the 6 info types and the 3 forecast slots
+#define ARENA_SIZE (9 * ARENA_ICON_SIZE)
+
+// Bump allocator over a static buffer for objects that live as long as the
+// main window. Nothing is freed on its own, arena_reset releases everything
+// at once on unload, so the heap never sees these allocations.
+
+/*
+ * Function Declarations
+ */
+
+// size bytes, 4 byte aligned, or NULL if the arena is full
+void *arena_alloc(size_t size);
+
+// Release all allocations. Pointers into the arena must be dropped first.
+void arena_reset();
+
+// Bytes allocated now and the most ever allocated at once
+size_t arena_used();
+size_t arena_peak();
+
+#endif // ARENA_H
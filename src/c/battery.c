@@ -4,70 +4,37 @@ GDrawCommandImage *s_battery_icon = NULL;
 char s_battery_buffer[5];
 int battery_level = 100;
 
-static void battery_icon_layer_update_proc(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
-  GPoint origin = GPoint((bounds.size.w - gdraw_command_image_get_bounds_size(s_battery_icon).w) / 2,
-                         (bounds.size.h - gdraw_command_image_get_bounds_size(s_battery_icon).h) / 2);
-  gdraw_command_image_draw(ctx, s_battery_icon, origin);
-}
-
 void load_battery_icon() {
-  load_pdc_icon(&s_battery_icon, RESOURCE_ID_IMAGE_BATTERY, ORIG_BATTERY_ICON_SIZE, BATTERY_ICON_SIZE);
+  load_pdc_icon(&s_battery_icon, RESOURCE_ID_IMAGE_BATTERY);
 }
 
 // Draw battery percentage in the specified info layer
-void draw_battery_info(InfoLayer* info_layer) {
-  GRect bounds = info_layer->bounds;
-  Layer* layer = info_layer->layer;
-  GRect bat_level_rect;
-
-  int x_pos = bounds.size.w / 2 - BATTERY_ICON_SIZE / 2;
-  int y_pos = bounds.size.h / 2 - BATTERY_ICON_SIZE / 2;
-  int y_offset = 0;
-  
-#if defined(PBL_PLATFORM_EMERY)
-  y_offset = 3;
-#endif
-
-  // Battery icon via PDC draw command
-  GRect icon_frame = GRect(x_pos, y_pos - 8 - y_offset, BATTERY_ICON_SIZE, BATTERY_ICON_SIZE);
-  info_layer->custom_layer = layer_create(icon_frame);
-  layer_set_update_proc(info_layer->custom_layer, battery_icon_layer_update_proc);
+static void draw_battery_info(InfoLayer* info_layer) {
+  DrawList *list = &info_layer->draw_list;
 
   // Draw a background rectangle for the battery level
-  int full_width = BATTERY_ICON_SIZE - BATTERY_ICON_SIZE * 1/6;
-  int full_height = BATTERY_ICON_SIZE / 2 - 2;
-
-  bat_level_rect = GRect(x_pos, y_pos, full_width, full_height);
-  info_layer->bitmap_layer_3 = bitmap_layer_create(bat_level_rect);
-  bitmap_layer_set_background_color(info_layer->bitmap_layer_3, get_background_color());
+  GRect bat_level_rect = info_layer->layout[LAYOUT_BATTERY_BAR];
+  draw_list_fill(list, bat_level_rect, get_background_color());
 
   // Battery level fill rectangle
-  int real_width = full_width * battery_level / 100;
-  bat_level_rect = GRect(x_pos, y_pos, real_width, full_height);
-  info_layer->bitmap_layer_2 = bitmap_layer_create(bat_level_rect);
-  bitmap_layer_set_background_color(info_layer->bitmap_layer_2, GColorLightGray);
+  bat_level_rect.size.w = bat_level_rect.size.w * battery_level / 100;
+  draw_list_fill(list, bat_level_rect, GColorLightGray);
 
   // Battery percentage text
 #if defined(PBL_PLATFORM_EMERY)
-  GRect text_frame = GRect(0, y_pos + 16, bounds.size.w, 28);
-#else
-  GRect text_frame = GRect(0, y_pos + 12, bounds.size.w, 24);
-#endif
-  info_layer->text_layer1 = text_layer_create(text_frame);
-  text_layer_set_background_color(info_layer->text_layer1, GColorClear);
-  text_layer_set_text_color(info_layer->text_layer1, get_text_color());
-  text_layer_set_text(info_layer->text_layer1, s_battery_buffer);
-#if defined(PBL_PLATFORM_EMERY)
-  text_layer_set_font(info_layer->text_layer1, fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD));
+  GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD);
 #else
-  text_layer_set_font(info_layer->text_layer1, fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD));
+  GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
 #endif
-  text_layer_set_text_alignment(info_layer->text_layer1, GTextAlignmentCenter);
+  draw_list_text(list, info_layer->layout[LAYOUT_BATTERY_TEXT], s_battery_buffer, font,
+                 get_text_color(), GTextAlignmentCenter);
 
-  // Add to the info layer
-  layer_add_child(layer, bitmap_layer_get_layer(info_layer->bitmap_layer_3));
-  layer_add_child(layer, bitmap_layer_get_layer(info_layer->bitmap_layer_2));
-  layer_add_child(layer, text_layer_get_layer(info_layer->text_layer1));
-  layer_add_child(layer, info_layer->custom_layer);
+  // Battery icon via PDC draw command
+  draw_list_icon(list, info_layer->layout[LAYOUT_BATTERY_ICON], &s_battery_icon, RESOURCE_ID_IMAGE_BATTERY);
 }
+
+const Widget battery_widget = {
+  .max_ops = 4,
+  .reads = STORE_BIT(STORE_BATTERY),
+  .update = draw_battery_info
+};
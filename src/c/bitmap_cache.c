@@ -0,0 +1,137 @@
+#include "bitmap_cache.h"
+#include "compositor.h"
+#include "memstats.h"
+
+static int bitmap_bytes(GSize size, GBitmapFormat format) {
+  if (format == GBitmapFormat1Bit) {
+    // 1-bit rows are padded to whole 32-bit words
+    return ((size.w + 31) / 32) * 4 * size.h;
+  }
+  return size.w * size.h;
+}
+
+bool bitmap_cache_has_headroom(int bytes) {
+  if ((int)heap_bytes_free() < bytes + BITMAP_CACHE_HEAP_RESERVE) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Bitmap cache skipped, %d bytes free", (int)heap_bytes_free());
+    return false;
+  }
+  return true;
+}
+
+GBitmap *bitmap_cache_create_bitmap(GSize size, GBitmapFormat format) {
+  if (!bitmap_cache_has_headroom(bitmap_bytes(size, format))) {
+    return NULL;
+  }
+  GBitmap *bitmap = gbitmap_create_blank(size, format);
+  if (bitmap) {
+    memstats_count(MEMSTATS_BITMAPS, bitmap_bytes(size, format));
+  }
+  return bitmap;
+}
+
+bool bitmap_cache_copy_from_framebuffer(GBitmap *framebuffer, GRect screen_rect, GBitmap *bitmap) {
+  GRect fb_bounds = gbitmap_get_bounds(framebuffer);
+  if (screen_rect.origin.x < 0 || screen_rect.origin.y < 0 ||
+      screen_rect.origin.x + screen_rect.size.w > fb_bounds.size.w ||
+      screen_rect.origin.y + screen_rect.size.h > fb_bounds.size.h) {
+    return false;
+  }
+
+  // Pixels outside the area being redrawn were not rendered this frame
+  GRect clip = compositor_clip();
+  if (screen_rect.origin.x < clip.origin.x || screen_rect.origin.y < clip.origin.y ||
+      screen_rect.origin.x + screen_rect.size.w > clip.origin.x + clip.size.w ||
+      screen_rect.origin.y + screen_rect.size.h > clip.origin.y + clip.size.h) {
+    return false;
+  }
+
+  uint8_t *src = gbitmap_get_data(framebuffer);
+  uint8_t *dst = gbitmap_get_data(bitmap);
+  const int src_stride = gbitmap_get_bytes_per_row(framebuffer);
+  const int dst_stride = gbitmap_get_bytes_per_row(bitmap);
+  const int x0 = screen_rect.origin.x;
+  const int w = screen_rect.size.w;
+
+  for (int y = 0; y < screen_rect.size.h; y++) {
+    uint8_t *src_row = src + (screen_rect.origin.y + y) * src_stride;
+    uint8_t *dst_row = dst + y * dst_stride;
+    if (gbitmap_get_format(framebuffer) == GBitmapFormat1Bit) {
+      if ((x0 & 7) == 0) {
+        memcpy(dst_row, src_row + x0 / 8, (w + 7) / 8);
+      } else {
+        // Unaligned 1-bit region: move pixel by pixel (pixels are LSB first)
+        memset(dst_row, 0, dst_stride);
+        for (int x = 0; x < w; x++) {
+          int sx = x0 + x;
+          if (src_row[sx / 8] & (1 << (sx % 8))) {
+            dst_row[x / 8] |= (1 << (x % 8));
+          }
+        }
+      }
+    } else {
+      memcpy(dst_row, src_row + x0, w);
+    }
+  }
+  return true;
+}
+
+bool bitmap_cache_draw(BitmapCache *cache, GContext *ctx, GRect rect, uint32_t key) {
+  if (!cache->valid || !cache->bitmap || cache->key != key) {
+    return false;
+  }
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+  graphics_draw_bitmap_in_rect(ctx, cache->bitmap, rect);
+  return true;
+}
+
+bool bitmap_cache_draw_part(BitmapCache *cache, GContext *ctx, GRect rect, GRect part, uint32_t key) {
+  if (!cache->valid || !cache->bitmap || cache->key != key) {
+    return false;
+  }
+  GRect full = gbitmap_get_bounds(cache->bitmap);
+  grect_clip(&part, &full);
+  if (part.size.w <= 0 || part.size.h <= 0) {
+    return true;
+  }
+  gbitmap_set_bounds(cache->bitmap, part);
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+  graphics_draw_bitmap_in_rect(ctx, cache->bitmap,
+      GRect(rect.origin.x + part.origin.x, rect.origin.y + part.origin.y, part.size.w, part.size.h));
+  gbitmap_set_bounds(cache->bitmap, full);
+  return true;
+}
+
+void bitmap_cache_store(BitmapCache *cache, GContext *ctx, GRect screen_rect, uint32_t key) {
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return;
+  }
+
+  // (Re)create the bitmap if the region size changed
+  if (cache->bitmap) {
+    GRect cached = gbitmap_get_bounds(cache->bitmap);
+    if (cached.size.w != screen_rect.size.w || cached.size.h != screen_rect.size.h) {
+      gbitmap_destroy(cache->bitmap);
+      cache->bitmap = NULL;
+    }
+  }
+  if (!cache->bitmap) {
+    cache->bitmap = bitmap_cache_create_bitmap(screen_rect.size, gbitmap_get_format(fb));
+  }
+
+  cache->valid = cache->bitmap && bitmap_cache_copy_from_framebuffer(fb, screen_rect, cache->bitmap);
+  cache->key = key;
+  graphics_release_frame_buffer(ctx, fb);
+}
+
+void bitmap_cache_invalidate(BitmapCache *cache) {
+  cache->valid = false;
+}
+
+void bitmap_cache_destroy(BitmapCache *cache) {
+  if (cache->bitmap) {
+    gbitmap_destroy(cache->bitmap);
+    cache->bitmap = NULL;
+  }
+  cache->valid = false;
+}
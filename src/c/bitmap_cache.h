@@ -0,0 +1,50 @@
+#ifndef BITMAP_CACHE_H
+#define BITMAP_CACHE_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Heap that must stay free after a cache bitmap has been allocated, so
+// that caching never starves layer or icon creation on small platforms.
+#define BITMAP_CACHE_HEAP_RESERVE 6144
+
+// An offscreen copy of already rendered framebuffer pixels. The key
+// describes the state the pixels were rendered for; a different key is a miss.
+typedef struct {
+  GBitmap *bitmap;
+  uint32_t key;
+  bool valid;
+} BitmapCache;
+
+/*
+ * Function Declarations
+ */
+
+// Blit the cached pixels into rect (layer coordinates). Returns false on a miss.
+bool bitmap_cache_draw(BitmapCache *cache, GContext *ctx, GRect rect, uint32_t key);
+
+// Blit only part (cache bitmap coordinates) of the cached pixels that
+// belong at rect. Returns false on a miss.
+bool bitmap_cache_draw_part(BitmapCache *cache, GContext *ctx, GRect rect, GRect part, uint32_t key);
+
+// Copy the framebuffer region screen_rect into the cache and tag it with key.
+// Does nothing if the region is not fully on screen or memory is short.
+void bitmap_cache_store(BitmapCache *cache, GContext *ctx, GRect screen_rect, uint32_t key);
+
+// Copy a framebuffer region into bitmap (same size and format). Used by all
+// helpers that snapshot already rendered pixels.
+bool bitmap_cache_copy_from_framebuffer(GBitmap *framebuffer, GRect screen_rect, GBitmap *bitmap);
+
+// Allocate a blank bitmap in the framebuffer format, honouring the heap reserve.
+GBitmap *bitmap_cache_create_bitmap(GSize size, GBitmapFormat format);
+
+// True if bytes can be allocated without eating into the heap reserve
+bool bitmap_cache_has_headroom(int bytes);
+
+void bitmap_cache_invalidate(BitmapCache *cache);
+void bitmap_cache_destroy(BitmapCache *cache);
+
+#endif // BITMAP_CACHE_H
@@ -0,0 +1,12 @@
+#include "colored_box.h"
+
+// Its simply a box with a border width 3 in the text color
+static void draw_colored_box_info(InfoLayer* info_layer) {
+  draw_list_fill(&info_layer->draw_list, info_layer->layout[LAYOUT_COLORED_BOX], get_text_color());
+}
+
+const Widget colored_box_widget = {
+  .max_ops = 1,
+  .reads = 0,
+  .update = draw_colored_box_info
+};
@@ -0,0 +1,10 @@
+#ifndef COLORED_BOX_H
+#define COLORED_BOX_H
+
+#include <pebble.h>
+#include "config.h"
+#include "widget.h"
+
+extern const Widget colored_box_widget;
+
+#endif // COLORED_BOX_H
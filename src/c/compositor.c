@@ -0,0 +1,278 @@
+#include "compositor.h"
+#include "bitmap_cache.h"
+#include "utils.h"
+
+// Layer stack: backdrop (clears the dirty rect), content (clipped to the
+// dirty rect, holds the scene layers) and capture (last child of content,
+// copies the redrawn rect into the retained scene). The window background
+// is clear, so outside the dirty rect the framebuffer keeps the last frame.
+static Layer *s_backdrop_layer = NULL;
+static Layer *s_content_layer = NULL;
+static Layer *s_capture_layer = NULL;
+static GRect s_bounds;
+
+// Last composited scene, without anything drawn above the content layer
+static BitmapCache s_scene;
+
+// Union of the rects changed since the last capture (screen coordinates).
+// s_captured is set once it was drawn, the next change starts a new union.
+static GRect s_dirty;
+static bool s_captured = false;
+static GRect s_clip;
+
+// The framebuffer was drawn over from outside, the next redraw copies the
+// whole retained scene back first
+static bool s_restore = false;
+
+// Layers are moving above the scene, every redraw is a full one
+static bool s_hold_all = false;
+
+#if defined(COMPOSITOR_DEBUG)
+// Start of the current redraw, for the cost measured by the capture layer
+static uint32_t s_frame_start_ms = 0;
+
+// Redraws since the last tick, summed per tick unit
+static struct {
+  uint32_t ticks;
+  uint32_t frames;
+  uint32_t pixels;
+  uint32_t ms;
+} s_bench[2];
+static int s_bench_unit = 0;
+#endif
+
+static bool rect_is_empty(GRect rect) {
+  return rect.size.w <= 0 || rect.size.h <= 0;
+}
+
+static GRect rect_union(GRect a, GRect b) {
+  if (rect_is_empty(a)) return b;
+  if (rect_is_empty(b)) return a;
+  const int x0 = a.origin.x < b.origin.x ? a.origin.x : b.origin.x;
+  const int y0 = a.origin.y < b.origin.y ? a.origin.y : b.origin.y;
+  const int x1 = a.origin.x + a.size.w > b.origin.x + b.size.w ? a.origin.x + a.size.w : b.origin.x + b.size.w;
+  const int y1 = a.origin.y + a.size.h > b.origin.y + b.size.h ? a.origin.y + a.size.h : b.origin.y + b.size.h;
+  return GRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+#if defined(COMPOSITOR_DEBUG)
+static uint32_t now_ms() {
+  time_t seconds;
+  uint16_t ms;
+  time_ms(&seconds, &ms);
+  return (uint32_t)seconds * 1000 + ms;
+}
+#endif
+
+static bool is_full_frame() {
+  return grect_equal(&s_dirty, &s_bounds);
+}
+
+// Clip the content layer to the dirty rect. The bounds origin compensates
+// the frame origin, so the scene layers keep their screen positions.
+static void apply_dirty() {
+  layer_set_frame(s_content_layer, s_dirty);
+  layer_set_bounds(s_content_layer, GRect(-s_dirty.origin.x, -s_dirty.origin.y,
+                                          s_bounds.size.w, s_bounds.size.h));
+  layer_mark_dirty(s_content_layer);
+}
+
+static void add_dirty(GRect screen_rect) {
+  grect_clip(&screen_rect, &s_bounds);
+  if (rect_is_empty(screen_rect)) {
+    return;
+  }
+  if (!s_scene.valid || s_hold_all) {
+    // Nothing retained yet or everything is drawn anyway
+    screen_rect = s_bounds;
+  }
+#if !defined(PBL_COLOR)
+  // Whole bytes of the 1-bit framebuffer, so the capture copies no pixel
+  // outside the rect
+  const int x1 = (screen_rect.origin.x + screen_rect.size.w + 7) & ~7;
+  screen_rect.origin.x &= ~7;
+  screen_rect.size.w = x1 - screen_rect.origin.x;
+  grect_clip(&screen_rect, &s_bounds);
+#endif
+  s_dirty = s_captured ? screen_rect : rect_union(s_dirty, screen_rect);
+  s_captured = false;
+  apply_dirty();
+}
+
+static void draw_backdrop(Layer *layer, GContext *ctx) {
+#if defined(COMPOSITOR_DEBUG)
+  s_frame_start_ms = now_ms();
+#endif
+  s_clip = s_dirty;
+  if (s_restore && s_scene.valid && !is_full_frame()) {
+    graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+    bitmap_cache_draw(&s_scene, ctx, s_bounds, s_scene.key);
+  }
+  s_restore = false;
+
+  // Only the dirty rect is cleared for the layers to redraw, the rest of
+  // the framebuffer still holds the scene
+  graphics_context_set_fill_color(ctx, get_background_color());
+  graphics_fill_rect(ctx, s_dirty, 0, GCornerNone);
+}
+
+// Copy rect of the framebuffer into the retained scene. Outside the dirty
+// rect the framebuffer may hold what was drawn above the content layer.
+static void copy_rect(GBitmap *fb, GBitmap *scene, GRect rect) {
+  uint8_t *src = gbitmap_get_data(fb);
+  uint8_t *dst = gbitmap_get_data(scene);
+  const int src_stride = gbitmap_get_bytes_per_row(fb);
+  const int dst_stride = gbitmap_get_bytes_per_row(scene);
+#if defined(PBL_COLOR)
+  const int x0 = rect.origin.x;
+  const int bytes = rect.size.w;
+#else
+  const int x0 = rect.origin.x / 8;
+  const int bytes = (rect.size.w + 7) / 8;
+#endif
+  for (int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+    memcpy(dst + y * dst_stride + x0, src + y * src_stride + x0, bytes);
+  }
+}
+
+#if defined(COMPOSITOR_DEBUG)
+static void bench_frame() {
+  s_bench[s_bench_unit].frames++;
+  s_bench[s_bench_unit].pixels += s_dirty.size.w * s_dirty.size.h;
+  s_bench[s_bench_unit].ms += now_ms() - s_frame_start_ms;
+}
+#endif
+
+static void draw_capture(Layer *layer, GContext *ctx) {
+  s_clip = s_bounds;
+  if (s_captured) {
+#if defined(COMPOSITOR_DEBUG)
+    bench_frame();
+#endif
+    return;
+  }
+
+  if (!s_scene.valid || is_full_frame()) {
+    bitmap_cache_store(&s_scene, ctx, s_bounds, 0);
+  } else {
+    GBitmap *fb = graphics_capture_frame_buffer(ctx);
+    if (fb) {
+      copy_rect(fb, s_scene.bitmap, s_dirty);
+      graphics_release_frame_buffer(ctx, fb);
+    } else {
+      bitmap_cache_invalidate(&s_scene);
+    }
+  }
+
+#if defined(COMPOSITOR_DEBUG)
+  bench_frame();
+#endif
+  s_captured = true;
+  if (!s_scene.valid) {
+    // Without a retained scene every frame is a full one
+    s_dirty = s_bounds;
+    s_captured = false;
+  }
+}
+
+void compositor_init(Layer *parent, GRect bounds) {
+  s_bounds = bounds;
+  s_dirty = bounds;
+  s_clip = bounds;
+  s_captured = false;
+
+  s_backdrop_layer = layer_create(bounds);
+  layer_set_update_proc(s_backdrop_layer, draw_backdrop);
+  layer_add_child(parent, s_backdrop_layer);
+
+  s_content_layer = layer_create(bounds);
+  layer_add_child(parent, s_content_layer);
+
+  s_capture_layer = layer_create(bounds);
+  layer_set_update_proc(s_capture_layer, draw_capture);
+  layer_add_child(s_content_layer, s_capture_layer);
+}
+
+void compositor_deinit() {
+  bitmap_cache_destroy(&s_scene);
+  if (s_capture_layer) {
+    layer_destroy(s_capture_layer);
+    s_capture_layer = NULL;
+  }
+  if (s_content_layer) {
+    layer_destroy(s_content_layer);
+    s_content_layer = NULL;
+  }
+  if (s_backdrop_layer) {
+    layer_destroy(s_backdrop_layer);
+    s_backdrop_layer = NULL;
+  }
+}
+
+void compositor_add_child(Layer *layer) {
+  layer_insert_below_sibling(layer, s_capture_layer);
+}
+
+void compositor_mark_dirty(Layer *layer, GRect rect) {
+  if (!s_content_layer) {
+    layer_mark_dirty(layer);
+    return;
+  }
+  add_dirty(layer_convert_rect_to_screen(layer, rect));
+}
+
+void compositor_mark_layer_dirty(Layer *layer) {
+  compositor_mark_dirty(layer, layer_get_bounds(layer));
+}
+
+void compositor_mark_all_dirty() {
+  if (!s_content_layer) {
+    return;
+  }
+  s_dirty = s_bounds;
+  s_captured = false;
+  apply_dirty();
+}
+
+void compositor_hold_all_dirty(bool hold) {
+  s_hold_all = hold;
+  if (hold) {
+    compositor_mark_all_dirty();
+  }
+}
+
+void compositor_restore() {
+  if (!s_content_layer) {
+    return;
+  }
+  if (!s_scene.valid) {
+    compositor_mark_all_dirty();
+    return;
+  }
+  s_restore = true;
+  layer_mark_dirty(s_backdrop_layer);
+}
+
+#if defined(COMPOSITOR_DEBUG)
+void compositor_bench_tick(bool minute) {
+  s_bench_unit = minute ? 1 : 0;
+  s_bench[s_bench_unit].ticks++;
+}
+
+void compositor_bench_log() {
+  static const char *const names[2] = { "second", "minute" };
+  for (int i = 0; i < 2; i++) {
+    const int ticks = s_bench[i].ticks > 0 ? s_bench[i].ticks : 1;
+    APP_LOG(APP_LOG_LEVEL_INFO, "Bench %s ticks: %d, per tick %d frames, %d px, %d ms (x100)",
+            names[i], (int)s_bench[i].ticks, (int)(s_bench[i].frames / ticks),
+            (int)(s_bench[i].pixels / ticks), (int)(s_bench[i].ms * 100 / ticks));
+  }
+}
+#endif
+
+GRect compositor_clip() {
+  if (!s_content_layer) {
+    return GRect(0, 0, INT16_MAX, INT16_MAX);
+  }
+  return s_clip;
+}
@@ -0,0 +1,66 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Producers report the rects they changed; on the next redraw only the
+// union of the changed rects is cleared and redrawn by the layers (their
+// parent is clipped to it). The window background has to be clear, the
+// rest of the framebuffer keeps the previous frame. The last composited
+// scene is also kept in an offscreen bitmap, to restore the framebuffer
+// after something else drew over it.
+
+// Benchmark of the redraws per tick: define to sum the frames, redrawn
+// pixels and time after each second and minute tick, logged when the
+// app closes. Compare the seconds tick (Show Seconds on) with the minute
+// path on a watch, the emulator does not time the drawing.
+// #define COMPOSITOR_DEBUG
+
+/*
+ * Function Declarations
+ */
+
+// Create the compositor layers as children of parent (full screen at 0,0)
+void compositor_init(Layer *parent, GRect bounds);
+
+void compositor_deinit();
+
+// Add a scene layer. Layers are stacked in the order they are added.
+void compositor_add_child(Layer *layer);
+
+// rect (layer coordinates) of layer changed and has to be redrawn
+void compositor_mark_dirty(Layer *layer, GRect rect);
+
+// All of layer changed
+void compositor_mark_layer_dirty(Layer *layer);
+
+// The whole scene changed (theme, settings)
+void compositor_mark_all_dirty();
+
+// While held every redraw is a full one. For layers moving above the
+// scene, which leave their old pixels in the framebuffer.
+void compositor_hold_all_dirty(bool hold);
+
+// The framebuffer no longer holds the scene (another window was shown),
+// copy it back from the retained bitmap on the next redraw
+void compositor_restore();
+
+#if defined(COMPOSITOR_DEBUG)
+// The redraws until the next call are caused by a second or minute tick
+void compositor_bench_tick(bool minute);
+
+void compositor_bench_log();
+#else
+  #define compositor_bench_tick(minute)
+  #define compositor_bench_log()
+#endif
+
+// Screen area the scene layers are currently redrawing. Code that reads or
+// writes the framebuffer directly has to stay inside it.
+GRect compositor_clip();
+
+#endif // COMPOSITOR_H
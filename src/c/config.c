@@ -1,5 +1,6 @@
 #include <pebble.h>
 #include "config.h"
+#include "journal.h"
 
 int s_color_theme = 0; // 0 = dark, 1 = light, 2 = auto day/night, 3 = auto quiet time
 int s_step_goal = 10000;
@@ -15,6 +16,10 @@ char s_date_format[16] = " %a %d"; // strftime format string for date display
 int s_light_show_background = 1; // 1 = show gray box in light theme, 0 = hide
 int s_dark_show_border = 1; // 1 = show border in dark theme, 0 = hide
 int s_vibrate_on_disconnect = 0; // 0 = disabled, 1 = vibrate on connect/disconnect
+int s_show_seconds = 0; // 0 = disabled, 1 = seconds tick on the upper line
+
+ThemeSnapshot s_theme;
+static bool s_theme_resolved = false;
 
 InfoLayer s_info_layers[NUM_INFO_LAYERS];
 InfoType s_layer_assignments[NUM_INFO_LAYERS] = {
@@ -25,23 +30,170 @@ InfoType s_layer_assignments[NUM_INFO_LAYERS] = {
 };
 
 
-// Persistent storage functions
-void save_theme_to_storage() {
-  persist_write_int(PERSIST_KEY_COLOR_THEME, s_color_theme);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved theme to storage: %d", s_color_theme);
-}
+// All settings in one persisted blob. Fields are only ever appended and
+// each addition bumps SETTINGS_VERSION. A blob of an older version is
+// shorter, so the fields it lacks keep their defaults.
+#define SETTINGS_VERSION 1
+
+typedef struct __attribute__((packed)) {
+  uint8_t version;
+  uint8_t color_theme : 2;
+  uint8_t temperature_unit : 1;
+  uint8_t enable_animations : 1;
+  uint8_t enable_mesh : 1;
+  uint8_t light_show_background : 1;
+  uint8_t dark_show_border : 1;
+  uint8_t vibrate_on_disconnect : 1;
+  uint8_t show_seconds : 1;
+  uint8_t weather_forecast_flick_mode : 2;
+  uint8_t reserved : 5;
+  uint8_t disconnect_position : 4;
+  uint8_t weather_forecast_duration : 4;
+  uint16_t layout;  // InfoType of each slot, 4 bits each
+  uint32_t step_goal;
+  char date_format[16];
+} SettingsBlob;
+
+// Keys of the settings before the blob, only read to migrate them
+static const uint32_t s_legacy_keys[] = {
+  PERSIST_KEY_COLOR_THEME, PERSIST_KEY_STEP_GOAL, PERSIST_KEY_TEMPERATURE_UNIT,
+  PERSIST_KEY_ENABLE_ANIMATIONS, PERSIST_KEY_LAYOUT_UPPER_LEFT, PERSIST_KEY_LAYOUT_UPPER_RIGHT,
+  PERSIST_KEY_LAYOUT_LOWER_LEFT, PERSIST_KEY_LAYOUT_LOWER_RIGHT, PERSIST_KEY_DISCONNECT_POSITION,
+  PERSIST_KEY_WEATHER_FORECAST_DURATION,
+  PERSIST_KEY_WEATHER_FORECAST_FLICK_MODE, PERSIST_KEY_ENABLE_MESH, PERSIST_KEY_DATE_FORMAT,
+  PERSIST_KEY_LIGHT_SHOW_BACKGROUND, PERSIST_KEY_DARK_SHOW_BORDER,
+  PERSIST_KEY_VIBRATE_ON_DISCONNECT, PERSIST_KEY_SHOW_SECONDS
+};
 
-void load_theme_from_storage() {
-  if (persist_exists(PERSIST_KEY_COLOR_THEME)) {
-    s_color_theme = persist_read_int(PERSIST_KEY_COLOR_THEME);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded theme from storage: %d", s_color_theme);
-  } else {
-    // Default to light theme if no preference exists
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No theme preference found, using default light theme");
+static void pack_settings(SettingsBlob *blob) {
+  memset(blob, 0, sizeof(*blob));
+  blob->version = SETTINGS_VERSION;
+  blob->color_theme = s_color_theme;
+  blob->temperature_unit = s_temperature_unit;
+  blob->enable_animations = s_enable_animations;
+  blob->enable_mesh = s_enable_mesh;
+  blob->light_show_background = s_light_show_background;
+  blob->dark_show_border = s_dark_show_border;
+  blob->vibrate_on_disconnect = s_vibrate_on_disconnect;
+  blob->show_seconds = s_show_seconds;
+  blob->weather_forecast_flick_mode = s_weather_forecast_flick_mode;
+  blob->disconnect_position = s_disconnect_position;
+  blob->weather_forecast_duration = s_weather_forecast_duration;
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    blob->layout |= (s_layer_assignments[i] & 0xF) << (4 * i);
+  }
+  blob->step_goal = s_step_goal;
+  strncpy(blob->date_format, s_date_format, sizeof(blob->date_format) - 1);
+}
+
+static void unpack_settings(const SettingsBlob *blob) {
+  s_color_theme = blob->color_theme;
+  s_temperature_unit = blob->temperature_unit;
+  s_enable_animations = blob->enable_animations;
+  s_enable_mesh = blob->enable_mesh;
+  s_light_show_background = blob->light_show_background;
+  s_dark_show_border = blob->dark_show_border;
+  s_vibrate_on_disconnect = blob->vibrate_on_disconnect;
+  s_show_seconds = blob->show_seconds;
+  s_weather_forecast_flick_mode = blob->weather_forecast_flick_mode;
+  s_disconnect_position = blob->disconnect_position;
+  s_weather_forecast_duration = blob->weather_forecast_duration;
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    s_layer_assignments[i] = (InfoType)((blob->layout >> (4 * i)) & 0xF);
+  }
+  s_step_goal = blob->step_goal;
+  memcpy(s_date_format, blob->date_format, sizeof(s_date_format));
+  s_date_format[sizeof(s_date_format) - 1] = '\0';
+}
+
+static size_t pack_settings_image(void *buffer) {
+  pack_settings(buffer);
+  return sizeof(SettingsBlob);
+}
+
+static int read_legacy_int(uint32_t key, int value) {
+  return persist_exists(key) ? persist_read_int(key) : value;
+}
+
+// Read the settings from their old keys (the defaults where missing)
+static void read_legacy_settings() {
+  s_color_theme = read_legacy_int(PERSIST_KEY_COLOR_THEME, s_color_theme);
+  s_step_goal = read_legacy_int(PERSIST_KEY_STEP_GOAL, s_step_goal);
+  s_temperature_unit = read_legacy_int(PERSIST_KEY_TEMPERATURE_UNIT, s_temperature_unit);
+  s_enable_animations = read_legacy_int(PERSIST_KEY_ENABLE_ANIMATIONS, s_enable_animations);
+  if (persist_exists(PERSIST_KEY_LAYOUT_UPPER_LEFT)) {
+    s_layer_assignments[LAYER_UPPER_LEFT] = persist_read_int(PERSIST_KEY_LAYOUT_UPPER_LEFT);
+    s_layer_assignments[LAYER_UPPER_RIGHT] = persist_read_int(PERSIST_KEY_LAYOUT_UPPER_RIGHT);
+    s_layer_assignments[LAYER_LOWER_LEFT] = persist_read_int(PERSIST_KEY_LAYOUT_LOWER_LEFT);
+    s_layer_assignments[LAYER_LOWER_RIGHT] = persist_read_int(PERSIST_KEY_LAYOUT_LOWER_RIGHT);
   }
-}
-
-bool is_dark_theme(){
+  s_disconnect_position = read_legacy_int(PERSIST_KEY_DISCONNECT_POSITION, s_disconnect_position);
+  s_weather_forecast_duration = read_legacy_int(PERSIST_KEY_WEATHER_FORECAST_DURATION, s_weather_forecast_duration);
+  s_weather_forecast_flick_mode = read_legacy_int(PERSIST_KEY_WEATHER_FORECAST_FLICK_MODE, s_weather_forecast_flick_mode);
+  s_enable_mesh = read_legacy_int(PERSIST_KEY_ENABLE_MESH, s_enable_mesh);
+  if (persist_exists(PERSIST_KEY_DATE_FORMAT)) {
+    persist_read_string(PERSIST_KEY_DATE_FORMAT, s_date_format, sizeof(s_date_format));
+  }
+  s_light_show_background = read_legacy_int(PERSIST_KEY_LIGHT_SHOW_BACKGROUND, s_light_show_background);
+  s_dark_show_border = read_legacy_int(PERSIST_KEY_DARK_SHOW_BORDER, s_dark_show_border);
+  s_vibrate_on_disconnect = read_legacy_int(PERSIST_KEY_VIBRATE_ON_DISCONNECT, s_vibrate_on_disconnect);
+  s_show_seconds = read_legacy_int(PERSIST_KEY_SHOW_SECONDS, s_show_seconds);
+}
+
+// Called whenever a valid blob is stored, so keys left by a migration whose
+// write failed are cleaned up on a later start
+static void delete_legacy_settings() {
+  for (unsigned i = 0; i < ARRAY_LENGTH(s_legacy_keys); i++) {
+    if (persist_exists(s_legacy_keys[i])) {
+      persist_delete(s_legacy_keys[i]);
+    }
+  }
+}
+
+void save_settings_to_storage() {
+  journal_mark(PERSIST_KEY_SETTINGS);
+}
+
+void load_settings_from_storage() {
+  if (!persist_exists(PERSIST_KEY_SETTINGS)) {
+    // First start with the blob: move the settings over from their old keys.
+    // The blob is written right away and the old keys are only deleted once
+    // it reads back valid, so a failed write loses nothing.
+    read_legacy_settings();
+    SettingsBlob blob;
+    pack_settings(&blob);
+    if (persist_write_data(PERSIST_KEY_SETTINGS, &blob, sizeof(blob)) != (int)sizeof(blob)) {
+      APP_LOG(APP_LOG_LEVEL_ERROR, "Could not migrate settings, keeping old keys");
+      journal_register_packed(PERSIST_KEY_SETTINGS, pack_settings_image, sizeof(SettingsBlob),
+                              NULL, 0);
+      return;
+    }
+    journal_register_packed(PERSIST_KEY_SETTINGS, pack_settings_image, sizeof(SettingsBlob),
+                            &blob, sizeof(blob));
+    delete_legacy_settings();
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Migrated settings to version %d", SETTINGS_VERSION);
+    return;
+  }
+
+  // Start from the defaults, so fields newer than the stored blob keep them
+  SettingsBlob blob;
+  pack_settings(&blob);
+  const int size = persist_read_data(PERSIST_KEY_SETTINGS, &blob, sizeof(blob));
+  journal_register_packed(PERSIST_KEY_SETTINGS, pack_settings_image, sizeof(SettingsBlob),
+                          &blob, size > 0 ? size : 0);
+  const int version = blob.version;
+  if (size > 0 && version != 0) {
+    delete_legacy_settings();
+  }
+  unpack_settings(&blob);
+  if (version != SETTINGS_VERSION) {
+    save_settings_to_storage();
+  }
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded settings version %d from storage", version);
+}
+
+// Theme setting resolved for the current time and weather
+static bool resolve_dark_theme(){
   if(s_color_theme == 0) {
     return true;
   }
@@ -55,198 +207,36 @@ bool is_dark_theme(){
   return false;
 }
 
-bool is_light_theme(){
-  return !is_dark_theme();
-}
-
-
-// Function to get colors based on theme
-GColor get_background_color() {
-  return is_light_theme() ? GColorWhite : GColorBlack;
-}
-
-GColor get_text_color() {
-  return is_light_theme() ? GColorBlack : GColorWhite;
-}
-
-void save_step_goal_to_storage() {
-  persist_write_int(PERSIST_KEY_STEP_GOAL, s_step_goal);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved step goal to storage: %d", s_step_goal);
-}
-
-void load_step_goal_from_storage() {
-  if (persist_exists(PERSIST_KEY_STEP_GOAL)) {
-    s_step_goal = persist_read_int(PERSIST_KEY_STEP_GOAL);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded step goal from storage: %d", s_step_goal);
-  } else {
-    // Default to 10000 if no preference exists
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No step goal preference found, using default 10000");
+// Resolve the effective theme into s_theme, returns true if it changed
+bool theme_refresh() {
+  const bool dark = resolve_dark_theme();
+  if (s_theme_resolved && dark == s_theme.dark) {
+    return false;
   }
+  s_theme_resolved = true;
+  s_theme.dark = dark;
+  s_theme.foreground = dark ? GColorWhite : GColorBlack;
+  s_theme.background = dark ? GColorBlack : GColorWhite;
+  // In light mode black text gets a white outline
+  s_theme.outline = dark ? GColorClear : GColorWhite;
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Theme resolved: %s", dark ? "dark" : "light");
+  return true;
 }
 
-void save_temperature_unit_to_storage() {
-  persist_write_int(PERSIST_KEY_TEMPERATURE_UNIT, s_temperature_unit);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved temperature unit to storage: %d", s_temperature_unit);
-}
-
-void load_temperature_unit_from_storage() {
-  if (persist_exists(PERSIST_KEY_TEMPERATURE_UNIT)) {
-    s_temperature_unit = persist_read_int(PERSIST_KEY_TEMPERATURE_UNIT);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded temperature unit from storage: %d", s_temperature_unit);
-  } else {
-    // Default to celsius if no preference exists
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No temperature unit preference found, using default celsius");
-  }
-}
-
-void save_enable_animations_to_storage() {
-  persist_write_int(PERSIST_KEY_ENABLE_ANIMATIONS, s_enable_animations);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved enable animations to storage: %d", s_enable_animations);
-}
-
-void load_enable_animations_from_storage() {
-  if (persist_exists(PERSIST_KEY_ENABLE_ANIMATIONS)) {
-    s_enable_animations = persist_read_int(PERSIST_KEY_ENABLE_ANIMATIONS);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded enable animations from storage: %d", s_enable_animations);
-  } else {
-    // Default to enabled if no preference exists
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No enable animations preference found, using default enabled");
-  }
-}
-
-void save_layout_to_storage() {
-  persist_write_int(PERSIST_KEY_LAYOUT_UPPER_LEFT, s_layer_assignments[LAYER_UPPER_LEFT]);
-  persist_write_int(PERSIST_KEY_LAYOUT_UPPER_RIGHT, s_layer_assignments[LAYER_UPPER_RIGHT]);
-  persist_write_int(PERSIST_KEY_LAYOUT_LOWER_LEFT, s_layer_assignments[LAYER_LOWER_LEFT]);
-  persist_write_int(PERSIST_KEY_LAYOUT_LOWER_RIGHT, s_layer_assignments[LAYER_LOWER_RIGHT]);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved layout to storage");
-}
-
-void load_layout_from_storage() {
-  if (persist_exists(PERSIST_KEY_LAYOUT_UPPER_LEFT)) {
-    s_layer_assignments[LAYER_UPPER_LEFT] = persist_read_int(PERSIST_KEY_LAYOUT_UPPER_LEFT);
-    s_layer_assignments[LAYER_UPPER_RIGHT] = persist_read_int(PERSIST_KEY_LAYOUT_UPPER_RIGHT);
-    s_layer_assignments[LAYER_LOWER_LEFT] = persist_read_int(PERSIST_KEY_LAYOUT_LOWER_LEFT);
-    s_layer_assignments[LAYER_LOWER_RIGHT] = persist_read_int(PERSIST_KEY_LAYOUT_LOWER_RIGHT);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded layout from storage");
-  }
-}
-
-void save_disconnect_position_to_storage() {
-  persist_write_int(PERSIST_KEY_DISCONNECT_POSITION, s_disconnect_position);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved disconnect position to storage: %d", s_disconnect_position);
-}
-
-void load_disconnect_position_from_storage() {
-  if (persist_exists(PERSIST_KEY_DISCONNECT_POSITION)) {
-    s_disconnect_position = persist_read_int(PERSIST_KEY_DISCONNECT_POSITION);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded disconnect position from storage: %d", s_disconnect_position);
-  } else {
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No disconnect position preference found, using default disabled");
-  }
-}
-
-
-void save_weather_forecast_duration_to_storage() {
-  persist_write_int(PERSIST_KEY_WEATHER_FORECAST_DURATION, s_weather_forecast_duration);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved weather forecast duration to storage: %d", s_weather_forecast_duration);
-}
-
-void load_weather_forecast_duration_from_storage() {
-  if (persist_exists(PERSIST_KEY_WEATHER_FORECAST_DURATION)) {
-    s_weather_forecast_duration = persist_read_int(PERSIST_KEY_WEATHER_FORECAST_DURATION);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded weather forecast duration from storage: %d", s_weather_forecast_duration);
-  } else {
-    s_weather_forecast_duration = 0; // Default to 5s
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No weather forecast duration preference found, using default 5s");
-  }
-}
-
-void save_weather_forecast_flick_mode_to_storage() {
-  persist_write_int(PERSIST_KEY_WEATHER_FORECAST_FLICK_MODE, s_weather_forecast_flick_mode);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved weather forecast flick mode to storage: %d", s_weather_forecast_flick_mode);
-}
-
-void load_weather_forecast_flick_mode_from_storage() {
-  if (persist_exists(PERSIST_KEY_WEATHER_FORECAST_FLICK_MODE)) {
-    s_weather_forecast_flick_mode = persist_read_int(PERSIST_KEY_WEATHER_FORECAST_FLICK_MODE);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded weather forecast flick mode from storage: %d", s_weather_forecast_flick_mode);
-  } else {
-    s_weather_forecast_flick_mode = 2; // Default to double flick
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No weather forecast flick mode preference found, using default double flick");
-  }
-}
-
-void save_enable_mesh_to_storage() {
-  persist_write_int(PERSIST_KEY_ENABLE_MESH, s_enable_mesh);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved enable mesh to storage: %d", s_enable_mesh);
-}
-
-void load_enable_mesh_from_storage() {
-  if (persist_exists(PERSIST_KEY_ENABLE_MESH)) {
-    s_enable_mesh = persist_read_int(PERSIST_KEY_ENABLE_MESH);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded enable mesh from storage: %d", s_enable_mesh);
-  } else {
-    s_enable_mesh = 1; // Default to enabled
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No enable mesh preference found, using default enabled");
-  }
-}
-
-void save_date_format_to_storage() {
-  persist_write_string(PERSIST_KEY_DATE_FORMAT, s_date_format);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved date format to storage: %s", s_date_format);
-}
-
-void load_date_format_from_storage() {
-  if (persist_exists(PERSIST_KEY_DATE_FORMAT)) {
-    persist_read_string(PERSIST_KEY_DATE_FORMAT, s_date_format, sizeof(s_date_format));
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded date format from storage: %s", s_date_format);
-  } else {
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No date format preference found, using default");
-  }
-}
-
-void save_light_show_background_to_storage() {
-  persist_write_int(PERSIST_KEY_LIGHT_SHOW_BACKGROUND, s_light_show_background);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved light show background to storage: %d", s_light_show_background);
+bool is_dark_theme(){
+  return s_theme.dark;
 }
 
-void load_light_show_background_from_storage() {
-  if (persist_exists(PERSIST_KEY_LIGHT_SHOW_BACKGROUND)) {
-    s_light_show_background = persist_read_int(PERSIST_KEY_LIGHT_SHOW_BACKGROUND);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded light show background from storage: %d", s_light_show_background);
-  } else {
-    s_light_show_background = 1; // Default to enabled
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No light show background preference found, using default enabled");
-  }
+bool is_light_theme(){
+  return !s_theme.dark;
 }
 
-void save_dark_show_border_to_storage() {
-  persist_write_int(PERSIST_KEY_DARK_SHOW_BORDER, s_dark_show_border);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved dark show border to storage: %d", s_dark_show_border);
-}
 
-void load_dark_show_border_from_storage() {
-  if (persist_exists(PERSIST_KEY_DARK_SHOW_BORDER)) {
-    s_dark_show_border = persist_read_int(PERSIST_KEY_DARK_SHOW_BORDER);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded dark show border from storage: %d", s_dark_show_border);
-  } else {
-    s_dark_show_border = 1; // Default to enabled
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No dark show border preference found, using default enabled");
-  }
+// Function to get colors based on theme
+GColor get_background_color() {
+  return s_theme.background;
 }
 
-void save_vibrate_on_disconnect_to_storage() {
-  persist_write_int(PERSIST_KEY_VIBRATE_ON_DISCONNECT, s_vibrate_on_disconnect);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved vibrate on disconnect to storage: %d", s_vibrate_on_disconnect);
+GColor get_text_color() {
+  return s_theme.foreground;
 }
-
-void load_vibrate_on_disconnect_from_storage() {
-  if (persist_exists(PERSIST_KEY_VIBRATE_ON_DISCONNECT)) {
-    s_vibrate_on_disconnect = persist_read_int(PERSIST_KEY_VIBRATE_ON_DISCONNECT);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded vibrate on disconnect from storage: %d", s_vibrate_on_disconnect);
-  } else {
-    s_vibrate_on_disconnect = 0; // Default to disabled
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "No vibrate on disconnect preference found, using default disabled");
-  }
-}
\ No newline at end of file
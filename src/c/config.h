@@ -2,9 +2,16 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include "draw_list.h"
+#include "generated/layout.h"
+
 /*
  * Definitions
  */
+
+// Settings and the current weather used to have a key each. Those keys are
+// moved into PERSIST_KEY_SETTINGS and PERSIST_KEY_WEATHER once and deleted,
+// only the forecast keys (16-20) are still in use.
 #define PERSIST_KEY_COLOR_THEME 1
 #define PERSIST_KEY_WEATHER_CODE 2
 #define PERSIST_KEY_TEMPERATURE 3
@@ -31,6 +38,9 @@
 #define PERSIST_KEY_LIGHT_SHOW_BACKGROUND 24
 #define PERSIST_KEY_DARK_SHOW_BORDER 25
 #define PERSIST_KEY_VIBRATE_ON_DISCONNECT 26
+#define PERSIST_KEY_SHOW_SECONDS 27
+#define PERSIST_KEY_SETTINGS 28
+#define PERSIST_KEY_WEATHER 29
 
 // Layer position and alignment enums
 typedef enum {
@@ -46,19 +56,11 @@ typedef enum {
   ALIGN_RIGHT = 1
 } InfoLayerAlignment;
 
-// Info layer structure with layer tracking
-typedef struct {
-  Layer* layer;
-  GRect bounds;
-  int position;
-  TextLayer* text_layer1;
-  TextLayer* text_layer2;
-  BitmapLayer* bitmap_layer_1; 
-  BitmapLayer* bitmap_layer_2;
-  BitmapLayer* bitmap_layer_3;
-  Layer* custom_layer;
-} InfoLayer;
-
+// Draw the whole face from one update proc instead of a layer per element.
+// Saves the layer allocations where the heap is smallest.
+#if defined(PBL_PLATFORM_APLITE)
+  #define FLAT_RENDER
+#endif
 
 // Layer assignment configuration - maps each layer position to an info type
 typedef enum {
@@ -73,6 +75,35 @@ typedef enum {
   INFO_TYPE_HEART_RATE = 8
 } InfoType;
 
+// Widget of an info type (see widget.h)
+typedef struct Widget Widget;
+
+// Info layer structure. The widget of the shown info type fills the draw
+// list (slot coordinates), which is drawn by the slot layer or, with
+// FLAT_RENDER, by the face (layer is NULL then). layout holds the element
+// rects for the slot size, indexed by LayoutElement.
+typedef struct {
+  Layer* layer;
+  GRect bounds;
+  int position;
+  InfoType type;
+  const Widget* widget;
+  const GRect* layout;
+  DrawList draw_list;
+} InfoLayer;
+
+// Effective theme. Resolved once per tick or event by theme_refresh(), the
+// drawing code only reads it (also through is_dark_theme() and the color
+// getters below).
+typedef struct {
+  bool dark;
+  GColor foreground;  // Text and lines
+  GColor background;
+  GColor outline;     // Around text over the mesh, GColorClear if none
+} ThemeSnapshot;
+
+extern ThemeSnapshot s_theme;
+
 // Current layer assignments (can be changed dynamically)
 extern InfoType s_layer_assignments[NUM_INFO_LAYERS];
 
@@ -96,36 +127,16 @@ extern char s_date_format[16]; // strftime format string for date display
 extern int s_light_show_background; // 1 = show gray box in light theme, 0 = hide
 extern int s_dark_show_border; // 1 = show border in dark theme, 0 = hide
 extern int s_vibrate_on_disconnect; // 1 = vibrate on connect/disconnect, 0 = disabled
+extern int s_show_seconds; // 1 = seconds tick on the upper line, 0 = disabled
 
 /*
  * Function Declarations
  */
-void save_theme_to_storage();
-void load_theme_from_storage();
-void save_step_goal_to_storage();
-void load_step_goal_from_storage();
-void save_temperature_unit_to_storage();
-void load_temperature_unit_from_storage();
-void save_enable_animations_to_storage();
-void load_enable_animations_from_storage();
-void save_layout_to_storage();
-void load_layout_from_storage();
-void save_disconnect_position_to_storage();
-void load_disconnect_position_from_storage();
-void save_weather_forecast_duration_to_storage();
-void load_weather_forecast_duration_from_storage();
-void save_weather_forecast_flick_mode_to_storage();
-void load_weather_forecast_flick_mode_from_storage();
-void save_enable_mesh_to_storage();
-void load_enable_mesh_from_storage();
-void save_date_format_to_storage();
-void load_date_format_from_storage();
-void save_light_show_background_to_storage();
-void load_light_show_background_from_storage();
-void save_dark_show_border_to_storage();
-void load_dark_show_border_from_storage();
-void save_vibrate_on_disconnect_to_storage();
-void load_vibrate_on_disconnect_from_storage();
+// All settings are persisted together (see SettingsBlob in config.c). Saving
+// only marks them, the journal writes them behind.
+void save_settings_to_storage();
+void load_settings_from_storage();
+bool theme_refresh();
 bool is_dark_theme();
 bool is_light_theme();
 GColor get_background_color();
@@ -0,0 +1,46 @@
+#include "deferred.h"
+
+static DeferredHandler s_handlers[NUM_DEFERRED_WORK];
+static uint32_t s_pending = 0;
+static bool s_batching = false;
+
+static void run(DeferredWork work) {
+  if (s_handlers[work]) {
+    s_handlers[work]();
+  }
+}
+
+void deferred_set_handler(DeferredWork work, DeferredHandler handler) {
+  s_handlers[work] = handler;
+}
+
+void deferred_request(DeferredWork work) {
+  if (s_batching) {
+    s_pending |= 1u << work;
+  } else {
+    run(work);
+  }
+}
+
+void deferred_begin() {
+  s_batching = true;
+}
+
+void deferred_end() {
+  // Handlers may request later work (retheme rebuilds the slots), so the
+  // lowest pending work is taken until nothing is left
+  while (s_pending) {
+    for (int work = 0; work < NUM_DEFERRED_WORK; work++) {
+      if (s_pending & (1u << work)) {
+        s_pending &= ~(1u << work);
+        run(work);
+        break;
+      }
+    }
+  }
+  s_batching = false;
+}
+
+bool deferred_pending(DeferredWork work) {
+  return (s_pending & (1u << work)) != 0;
+}
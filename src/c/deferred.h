@@ -0,0 +1,40 @@
+#ifndef DEFERRED_H
+#define DEFERRED_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Work that several parts of one event may ask for. Inside a batch each
+// is only recorded and runs once when the batch ends, in this order.
+typedef enum {
+  DEFERRED_FORECAST_ICONS = 0,   // Reload the forecast panel icons
+  DEFERRED_RETHEME,              // Apply the effective theme
+  DEFERRED_RETIME,               // Reformat time and date
+  DEFERRED_COMMIT,               // Commit the store changes of the batch
+  DEFERRED_REBUILD_SLOTS,        // Rebind and rebuild all info slots
+  NUM_DEFERRED_WORK
+} DeferredWork;
+
+typedef void (*DeferredHandler)();
+
+/*
+ * Function Declarations
+ */
+
+void deferred_set_handler(DeferredWork work, DeferredHandler handler);
+
+// Ask for work. Outside a batch it runs right away.
+void deferred_request(DeferredWork work);
+
+// Start and end a batch (one event). Work requested while the batch runs
+// its handlers is run in the same batch.
+void deferred_begin();
+void deferred_end();
+
+// True if work was requested in the running batch and has not run yet
+bool deferred_pending(DeferredWork work);
+
+#endif // DEFERRED_H
@@ -3,17 +3,11 @@
 
 #include <pebble.h>
 #include "config.h"
-
-#define ORIG_DISCONNECT_ICON_SIZE 25
-#if defined(PBL_PLATFORM_EMERY)
-  #define DISCONNECT_ICON_SIZE 44
-#else
-  #define DISCONNECT_ICON_SIZE 32
-#endif
+#include "widget.h"
 
 extern GDrawCommandImage *s_disconnect_icon;
 
-void draw_disconnect_info(InfoLayer* info_layer);
+extern const Widget disconnect_widget;
 void load_disconnect_icon();
 
 #endif // DISCONNECT_H
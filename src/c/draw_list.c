@@ -0,0 +1,93 @@
+#include "draw_list.h"
+#include "icon_cache.h"
+
+static DrawOp *add_op(DrawList *list, DrawOpType type, GRect rect) {
+  if (list->count >= list->capacity) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Draw list full, entry dropped");
+    return NULL;
+  }
+  DrawOp *op = &list->ops[list->count++];
+  memset(op, 0, sizeof(*op));
+  op->type = type;
+  op->rect = rect;
+  return op;
+}
+
+void draw_list_init(DrawList *list, DrawOp *ops, int capacity) {
+  list->ops = ops;
+  list->capacity = capacity;
+  list->count = 0;
+}
+
+void draw_list_clear(DrawList *list) {
+  list->count = 0;
+}
+
+void draw_list_fill(DrawList *list, GRect rect, GColor color) {
+  DrawOp *op = add_op(list, DRAW_OP_FILL, rect);
+  if (op) {
+    op->color = color;
+  }
+}
+
+void draw_list_text(DrawList *list, GRect rect, const char *text, GFont font,
+                    GColor color, GTextAlignment alignment) {
+  DrawOp *op = add_op(list, DRAW_OP_TEXT, rect);
+  if (op) {
+    op->text = text;
+    strncpy(op->text_value, text, sizeof(op->text_value) - 1);
+    op->font = font;
+    op->color = color;
+    op->alignment = alignment;
+  }
+}
+
+void draw_list_icon(DrawList *list, GRect rect, GDrawCommandImage **icon, uint32_t resource_id) {
+  DrawOp *op = add_op(list, DRAW_OP_ICON, rect);
+  if (op) {
+    op->icon = icon;
+    op->resource_id = resource_id;
+  }
+}
+
+void draw_list_copy(DrawList *dst, const DrawList *src) {
+  dst->count = src->count < dst->capacity ? src->count : dst->capacity;
+  memcpy(dst->ops, src->ops, dst->count * sizeof(DrawOp));
+}
+
+bool draw_list_equal(const DrawList *a, const DrawList *b) {
+  // Entries are zeroed before they are filled, so padding compares equal too
+  return a->count == b->count && memcmp(a->ops, b->ops, a->count * sizeof(DrawOp)) == 0;
+}
+
+void draw_list_render(const DrawList *list, GContext *ctx, Layer *layer, GPoint origin) {
+  for (int i = 0; i < list->count; i++) {
+    const DrawOp *op = &list->ops[i];
+    GRect rect = op->rect;
+    rect.origin.x += origin.x;
+    rect.origin.y += origin.y;
+
+    switch (op->type) {
+      case DRAW_OP_FILL:
+        graphics_context_set_fill_color(ctx, op->color);
+        graphics_fill_rect(ctx, rect, 0, GCornerNone);
+        break;
+      case DRAW_OP_TEXT:
+        graphics_context_set_text_color(ctx, op->color);
+        graphics_draw_text(ctx, op->text, op->font, rect,
+                           GTextOverflowModeWordWrap, op->alignment, NULL);
+        break;
+      case DRAW_OP_ICON: {
+        GDrawCommandImage *icon = *op->icon;
+        if (!icon) {
+          break;
+        }
+        GSize size = gdraw_command_image_get_bounds_size(icon);
+        GPoint icon_origin = GPoint(rect.origin.x + (rect.size.w - size.w) / 2,
+                                    rect.origin.y + (rect.size.h - size.h) / 2);
+        icon_cache_draw(ctx, layer, icon, op->resource_id, icon_origin);
+        break;
+      }
+    }
+  }
+}
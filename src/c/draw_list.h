@@ -0,0 +1,63 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+typedef enum {
+  DRAW_OP_FILL,   // Filled rectangle
+  DRAW_OP_TEXT,   // Text in a box, like a TextLayer with a clear background
+  DRAW_OP_ICON    // PDC icon centered in the box
+} DrawOpType;
+
+// Longest text kept for the comparison of lists (s_location_buffer)
+#define DRAW_TEXT_MAX_SIZE 20
+
+// One drawing step. Text and icons are referenced, not copied, so that
+// updating the buffer or reloading the icon is seen on the next draw.
+// text_value is copied when the text is added, so lists built before and
+// after a buffer update differ.
+typedef struct {
+  DrawOpType type;
+  GRect rect;
+  GColor color;
+  const char *text;
+  char text_value[DRAW_TEXT_MAX_SIZE];
+  GFont font;
+  GTextAlignment alignment;
+  GDrawCommandImage **icon;
+  uint32_t resource_id;
+} DrawOp;
+
+// List of drawing steps, drawn in the order they were added. The entries
+// live in storage handed to draw_list_init (see the widget arena).
+typedef struct {
+  DrawOp *ops;
+  uint8_t capacity;
+  uint8_t count;
+} DrawList;
+
+/*
+ * Function Declarations
+ */
+
+void draw_list_init(DrawList *list, DrawOp *ops, int capacity);
+void draw_list_clear(DrawList *list);
+void draw_list_fill(DrawList *list, GRect rect, GColor color);
+void draw_list_text(DrawList *list, GRect rect, const char *text, GFont font,
+                    GColor color, GTextAlignment alignment);
+void draw_list_icon(DrawList *list, GRect rect, GDrawCommandImage **icon, uint32_t resource_id);
+
+// Copy the entries of src into dst (up to the capacity of dst)
+void draw_list_copy(DrawList *dst, const DrawList *src);
+
+// True if both lists hold the same entries, so they draw the same
+bool draw_list_equal(const DrawList *a, const DrawList *b);
+
+// Draw all entries, offset by origin (layer coordinates)
+void draw_list_render(const DrawList *list, GContext *ctx, Layer *layer, GPoint origin);
+
+#endif // DRAW_LIST_H
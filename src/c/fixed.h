@@ -0,0 +1,38 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Q16.16 fixed point numbers for the render paths, the watches have no FPU
+// and every float operation would be a soft-float library call.
+typedef int32_t fixed_t;
+
+#define FIXED_SHIFT 16
+#define FIXED_ONE ((fixed_t)1 << FIXED_SHIFT)
+
+// Fractions are rounded up. Scaling an integer by a fraction then truncates
+// to the exact result whenever the exact product is a whole number (e.g.
+// 3 of 12 segments at 25%), where a rounded down 0.25 would give 2.
+
+// Constant fraction num/den, e.g. FIXED_FRAC(4, 5) for 0.8
+#define FIXED_FRAC(num, den) ((fixed_t)((((int64_t)(num) << FIXED_SHIFT) + (den) - 1) / (den)))
+
+/*
+ * Function Declarations
+ */
+
+// num/den for small non-negative integers (num < 32768)
+static inline fixed_t fixed_from_ratio(int num, int den) {
+  return (fixed_t)(((num << FIXED_SHIFT) + den - 1) / den);
+}
+
+// value * f, truncated like the integer cast of a float product
+static inline int fixed_mul_int(fixed_t f, int value) {
+  return (int)((f * value) >> FIXED_SHIFT);
+}
+
+#endif // FIXED_H
@@ -0,0 +1,319 @@
+#include "glyph_atlas.h"
+#include "bitmap_cache.h"
+#include "utils.h"
+#include "memstats.h"
+
+// All glyphs side by side, one cell of cell_w x cell_h each
+static struct {
+  GFont font;
+  bool light;
+  bool valid;
+  int cell_w;
+  int cell_h;
+  int16_t advance[GLYPH_ATLAS_NUM_CHARS];
+#if defined(PBL_COLOR)
+  GBitmap *glyphs;      // 2-bit palette: transparent, white, black
+#else
+  GBitmap *white_mask;  // 1 where the glyph is white, composited with GCompOpOr
+  GBitmap *black_mask;  // 0 where the glyph is black, composited with GCompOpAnd
+#endif
+} s_atlas;
+
+#if defined(PBL_COLOR)
+static GColor s_palette[4];
+#endif
+
+static int glyph_index(char c) {
+  const char *p = strchr(GLYPH_ATLAS_CHARS, c);
+  return (c && p) ? (int)(p - GLYPH_ATLAS_CHARS) : -1;
+}
+
+static bool atlas_serves(const char *text) {
+  for (const char *p = text; *p; p++) {
+    if (glyph_index(*p) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int text_width(const char *text) {
+  int width = 0;
+  for (const char *p = text; *p; p++) {
+    width += s_atlas.advance[glyph_index(*p)];
+  }
+  return width;
+}
+
+static void free_bitmaps() {
+#if defined(PBL_COLOR)
+  if (s_atlas.glyphs) {
+    gbitmap_destroy(s_atlas.glyphs);
+    s_atlas.glyphs = NULL;
+  }
+#else
+  if (s_atlas.white_mask) {
+    gbitmap_destroy(s_atlas.white_mask);
+    s_atlas.white_mask = NULL;
+  }
+  if (s_atlas.black_mask) {
+    gbitmap_destroy(s_atlas.black_mask);
+    s_atlas.black_mask = NULL;
+  }
+#endif
+  s_atlas.valid = false;
+}
+
+static bool alloc_bitmaps() {
+  GSize size = GSize(s_atlas.cell_w * GLYPH_ATLAS_NUM_CHARS, s_atlas.cell_h);
+#if defined(PBL_COLOR)
+  if (!bitmap_cache_has_headroom((size.w + 3) / 4 * size.h)) {
+    return false;
+  }
+  s_palette[0] = GColorClear;
+  s_palette[1] = GColorWhite;
+  s_palette[2] = GColorBlack;
+  s_palette[3] = GColorClear;
+  s_atlas.glyphs = gbitmap_create_blank_with_palette(size, GBitmapFormat2BitPalette, s_palette, false);
+  if (s_atlas.glyphs) {
+    memstats_count(MEMSTATS_BITMAPS, (size.w + 3) / 4 * size.h);
+  }
+  return s_atlas.glyphs != NULL;
+#else
+  s_atlas.white_mask = bitmap_cache_create_bitmap(size, GBitmapFormat1Bit);
+  s_atlas.black_mask = bitmap_cache_create_bitmap(size, GBitmapFormat1Bit);
+  if (!s_atlas.white_mask || !s_atlas.black_mask) {
+    return false;
+  }
+  // Everything not black is left untouched by the AND pass
+  memset(gbitmap_get_data(s_atlas.black_mask), 0xFF,
+         gbitmap_get_bytes_per_row(s_atlas.black_mask) * size.h);
+  return true;
+#endif
+}
+
+static bool fb_pixel_is(GBitmap *fb, int x, int y, GColor color) {
+  uint8_t *row = gbitmap_get_data(fb) + y * gbitmap_get_bytes_per_row(fb);
+  if (gbitmap_get_format(fb) == GBitmapFormat1Bit) {
+    bool white = row[x / 8] & (1 << (x % 8));
+    return white == gcolor_equal(color, GColorWhite);
+  }
+  return row[x] == color.argb;
+}
+
+// Record the pixels of the glyph in the given color at atlas column x_offset
+static void record_pixels(GBitmap *fb, GRect screen_cell, int x_offset, GColor color) {
+  for (int y = 0; y < screen_cell.size.h; y++) {
+    for (int x = 0; x < screen_cell.size.w; x++) {
+      if (!fb_pixel_is(fb, screen_cell.origin.x + x, screen_cell.origin.y + y, color)) {
+        continue;
+      }
+      const int ax = x_offset + x;
+#if defined(PBL_COLOR)
+      // Palettized formats store the leftmost pixel in the most significant bits
+      uint8_t *row = gbitmap_get_data(s_atlas.glyphs) + y * gbitmap_get_bytes_per_row(s_atlas.glyphs);
+      const int shift = 6 - 2 * (ax % 4);
+      const uint8_t index = gcolor_equal(color, GColorWhite) ? 1 : 2;
+      row[ax / 4] = (row[ax / 4] & ~(3 << shift)) | (index << shift);
+#else
+      if (gcolor_equal(color, GColorWhite)) {
+        uint8_t *row = gbitmap_get_data(s_atlas.white_mask) + y * gbitmap_get_bytes_per_row(s_atlas.white_mask);
+        row[ax / 8] |= (1 << (ax % 8));
+      } else {
+        uint8_t *row = gbitmap_get_data(s_atlas.black_mask) + y * gbitmap_get_bytes_per_row(s_atlas.black_mask);
+        row[ax / 8] &= ~(1 << (ax % 8));
+      }
+#endif
+    }
+  }
+}
+
+// Render one glyph on a solid background and record everything that is not
+// background. Done once on black (finds white pixels) and once on white
+// (finds black pixels), which separates outline, glyph and transparency.
+static void bake_glyph(GContext *ctx, int index, GRect local_cell, GRect screen_cell) {
+  char text[2] = { GLYPH_ATLAS_CHARS[index], '\0' };
+  GRect text_box = GRect(local_cell.origin.x + GLYPH_ATLAS_PAD, local_cell.origin.y + GLYPH_ATLAS_PAD,
+                         local_cell.size.w - GLYPH_ATLAS_PAD, local_cell.size.h - GLYPH_ATLAS_PAD);
+
+  for (int pass = 0; pass < 2; pass++) {
+    GColor background = pass == 0 ? GColorBlack : GColorWhite;
+    GColor recorded = pass == 0 ? GColorWhite : GColorBlack;
+    graphics_context_set_fill_color(ctx, background);
+    graphics_fill_rect(ctx, local_cell, 0, GCornerNone);
+    draw_theme_text(ctx, text, s_atlas.font, text_box, GTextAlignmentLeft, s_atlas.light);
+
+    GBitmap *fb = graphics_capture_frame_buffer(ctx);
+    if (fb) {
+      record_pixels(fb, screen_cell, index * s_atlas.cell_w, recorded);
+      graphics_release_frame_buffer(ctx, fb);
+    }
+  }
+}
+
+static bool bake(GContext *ctx, Layer *layer, GFont font, bool light) {
+  s_atlas.font = font;
+  s_atlas.light = light;
+  s_atlas.valid = false;
+
+  // Measure the glyphs
+  int max_advance = 0;
+  int line_height = 0;
+  for (int i = 0; i < GLYPH_ATLAS_NUM_CHARS; i++) {
+    char text[2] = { GLYPH_ATLAS_CHARS[i], '\0' };
+    GSize size = graphics_text_layout_get_content_size(text, font, GRect(0, 0, 200, 200),
+                                                       GTextOverflowModeWordWrap, GTextAlignmentLeft);
+    s_atlas.advance[i] = size.w;
+    if (size.w > max_advance) max_advance = size.w;
+    if (size.h > line_height) line_height = size.h;
+  }
+
+  const int cell_w = max_advance + 2 * GLYPH_ATLAS_PAD;
+  const int cell_h = line_height + 2 * GLYPH_ATLAS_PAD;
+  if (cell_w != s_atlas.cell_w || cell_h != s_atlas.cell_h) {
+    free_bitmaps();
+    s_atlas.cell_w = cell_w;
+    s_atlas.cell_h = cell_h;
+  }
+#if defined(PBL_COLOR)
+  bool allocated = s_atlas.glyphs != NULL;
+#else
+  bool allocated = s_atlas.white_mask != NULL && s_atlas.black_mask != NULL;
+#endif
+  if (!allocated) {
+    free_bitmaps();
+    if (!alloc_bitmaps()) {
+      free_bitmaps();
+      return false;
+    }
+  } else {
+    // Clear the previous variant
+#if defined(PBL_COLOR)
+    memset(gbitmap_get_data(s_atlas.glyphs), 0, gbitmap_get_bytes_per_row(s_atlas.glyphs) * cell_h);
+#else
+    memset(gbitmap_get_data(s_atlas.white_mask), 0x00, gbitmap_get_bytes_per_row(s_atlas.white_mask) * cell_h);
+    memset(gbitmap_get_data(s_atlas.black_mask), 0xFF, gbitmap_get_bytes_per_row(s_atlas.black_mask) * cell_h);
+#endif
+  }
+
+  // The glyphs are rendered in the top left corner of the layer, which is
+  // saved beforehand and restored afterwards
+  GRect local_cell = GRect(0, 0, cell_w, cell_h);
+  GRect screen_cell = layer_convert_rect_to_screen(layer, local_cell);
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return false;
+  }
+  GBitmap *saved = bitmap_cache_create_bitmap(local_cell.size, gbitmap_get_format(fb));
+  bool saved_ok = saved && bitmap_cache_copy_from_framebuffer(fb, screen_cell, saved);
+  graphics_release_frame_buffer(ctx, fb);
+  if (!saved_ok) {
+    if (saved) gbitmap_destroy(saved);
+    return false;
+  }
+
+  for (int i = 0; i < GLYPH_ATLAS_NUM_CHARS; i++) {
+    bake_glyph(ctx, i, local_cell, screen_cell);
+  }
+
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+  graphics_draw_bitmap_in_rect(ctx, saved, local_cell);
+  gbitmap_destroy(saved);
+
+  s_atlas.valid = true;
+  return true;
+}
+
+static void draw_cell(GContext *ctx, GBitmap *bitmap, int index, GRect dest) {
+  gbitmap_set_bounds(bitmap, GRect(index * s_atlas.cell_w, 0, s_atlas.cell_w, s_atlas.cell_h));
+  graphics_draw_bitmap_in_rect(ctx, bitmap, dest);
+}
+
+bool glyph_atlas_draw_text(GContext *ctx, Layer *layer, GFont font, const char *text, GRect bounds, bool light) {
+  // Only strings made of atlas glyphs can be served
+  if (!atlas_serves(text)) {
+    return false;
+  }
+  if (!s_atlas.valid || s_atlas.font != font || s_atlas.light != light) {
+    if (!bake(ctx, layer, font, light)) {
+      return false;
+    }
+  }
+
+  // Center the line like GTextAlignmentCenter does
+  int x = bounds.origin.x + (bounds.size.w - text_width(text)) / 2;
+
+  for (const char *p = text; *p; p++) {
+    const int index = glyph_index(*p);
+    GRect dest = GRect(x - GLYPH_ATLAS_PAD, bounds.origin.y - GLYPH_ATLAS_PAD, s_atlas.cell_w, s_atlas.cell_h);
+#if defined(PBL_COLOR)
+    graphics_context_set_compositing_mode(ctx, GCompOpSet);
+    draw_cell(ctx, s_atlas.glyphs, index, dest);
+#else
+    graphics_context_set_compositing_mode(ctx, GCompOpOr);
+    draw_cell(ctx, s_atlas.white_mask, index, dest);
+    graphics_context_set_compositing_mode(ctx, GCompOpAnd);
+    draw_cell(ctx, s_atlas.black_mask, index, dest);
+#endif
+    x += s_atlas.advance[index];
+  }
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+  return true;
+}
+
+// Cells of the characters first..last as blitted by glyph_atlas_draw_text
+static GRect cells_rect(const char *text, GRect bounds, int first, int last) {
+  int x = bounds.origin.x + (bounds.size.w - text_width(text)) / 2;
+  int x0 = 0;
+  for (int i = 0; i <= last; i++) {
+    if (i == first) {
+      x0 = x;
+    }
+    if (i < last) {
+      x += s_atlas.advance[glyph_index(text[i])];
+    }
+  }
+  return GRect(x0 - GLYPH_ATLAS_PAD, bounds.origin.y - GLYPH_ATLAS_PAD,
+               x - x0 + s_atlas.cell_w, s_atlas.cell_h);
+}
+
+GRect glyph_atlas_changed_rect(GFont font, const char *old_text, const char *new_text, GRect bounds) {
+  if (!s_atlas.valid || s_atlas.font != font || !atlas_serves(old_text) || !atlas_serves(new_text)) {
+    return bounds;
+  }
+
+  const int old_len = strlen(old_text);
+  const int new_len = strlen(new_text);
+  if (old_len != new_len || text_width(old_text) != text_width(new_text)) {
+    // The centered line moves, everything of both lines changes
+    GRect old_rect = old_len ? cells_rect(old_text, bounds, 0, old_len - 1) : GRectZero;
+    GRect new_rect = new_len ? cells_rect(new_text, bounds, 0, new_len - 1) : GRectZero;
+    if (!old_len) return new_rect;
+    if (!new_len) return old_rect;
+    const int x0 = old_rect.origin.x < new_rect.origin.x ? old_rect.origin.x : new_rect.origin.x;
+    const int x1 = old_rect.origin.x + old_rect.size.w > new_rect.origin.x + new_rect.size.w
+                   ? old_rect.origin.x + old_rect.size.w : new_rect.origin.x + new_rect.size.w;
+    return GRect(x0, old_rect.origin.y, x1 - x0, old_rect.size.h);
+  }
+
+  // Same layout: only the characters that differ
+  int first = -1;
+  int last = -1;
+  for (int i = 0; i < new_len; i++) {
+    if (old_text[i] != new_text[i]) {
+      if (first < 0) first = i;
+      last = i;
+    }
+  }
+  if (first < 0) {
+    return GRectZero;
+  }
+  return cells_rect(new_text, bounds, first, last);
+}
+
+void glyph_atlas_destroy() {
+  free_bitmaps();
+  s_atlas.cell_w = 0;
+  s_atlas.cell_h = 0;
+  s_atlas.font = NULL;
+}
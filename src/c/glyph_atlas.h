@@ -0,0 +1,33 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Characters baked into the atlas (everything the time display can show)
+#define GLYPH_ATLAS_CHARS "0123456789:"
+#define GLYPH_ATLAS_NUM_CHARS 11
+
+// Free pixels around each glyph cell, room for the 1px outline
+#define GLYPH_ATLAS_PAD 2
+
+/*
+ * Function Declarations
+ */
+
+// Draw text centered in bounds (layer coordinates) by blitting pre-outlined
+// glyphs, one per character. The atlas is baked from font on first use and
+// again whenever the light/dark variant changes. Returns false if the text
+// can not be served from the atlas, the caller then draws it as usual.
+bool glyph_atlas_draw_text(GContext *ctx, Layer *layer, GFont font, const char *text, GRect bounds, bool light);
+
+// Part of bounds (layer coordinates) that changes when new_text replaces
+// old_text. All of bounds if the atlas has not been baked for font yet.
+GRect glyph_atlas_changed_rect(GFont font, const char *old_text, const char *new_text, GRect bounds);
+
+void glyph_atlas_destroy();
+
+#endif // GLYPH_ATLAS_H
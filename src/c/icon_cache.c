@@ -0,0 +1,235 @@
+#include "icon_cache.h"
+#include "bitmap_cache.h"
+#include "compositor.h"
+#include "config.h"
+
+typedef struct {
+  uint32_t resource_id;
+  GSize size;
+  bool light;
+  bool valid;
+  uint32_t last_used;
+#if defined(PBL_COLOR)
+  GBitmap *pixels;      // 8-bit ARGB, alpha 0 where the icon is transparent
+#else
+  GBitmap *white_mask;  // 1 where the icon is white, composited with GCompOpOr
+  GBitmap *black_mask;  // 0 where the icon is black, composited with GCompOpAnd
+#endif
+} IconCacheEntry;
+
+static IconCacheEntry s_entries[ICON_CACHE_SLOTS];
+static uint32_t s_use_counter = 0;
+
+static void free_entry(IconCacheEntry *entry) {
+#if defined(PBL_COLOR)
+  if (entry->pixels) {
+    gbitmap_destroy(entry->pixels);
+    entry->pixels = NULL;
+  }
+#else
+  if (entry->white_mask) {
+    gbitmap_destroy(entry->white_mask);
+    entry->white_mask = NULL;
+  }
+  if (entry->black_mask) {
+    gbitmap_destroy(entry->black_mask);
+    entry->black_mask = NULL;
+  }
+#endif
+  entry->valid = false;
+}
+
+static IconCacheEntry *find_entry(uint32_t resource_id, GSize size, bool light) {
+  for (int i = 0; i < ICON_CACHE_SLOTS; i++) {
+    IconCacheEntry *entry = &s_entries[i];
+    if (entry->valid && entry->resource_id == resource_id && entry->light == light &&
+        entry->size.w == size.w && entry->size.h == size.h) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+// A free slot, or the least recently drawn one
+static IconCacheEntry *victim_entry() {
+  IconCacheEntry *victim = &s_entries[0];
+  for (int i = 0; i < ICON_CACHE_SLOTS; i++) {
+    if (!s_entries[i].valid) {
+      return &s_entries[i];
+    }
+    if (s_entries[i].last_used < victim->last_used) {
+      victim = &s_entries[i];
+    }
+  }
+  return victim;
+}
+
+#if defined(PBL_COLOR)
+static uint8_t unpremultiply(int channel, int alpha) {
+  const int value = (channel * 3 + alpha / 2) / alpha;
+  return value > 3 ? 3 : value;
+}
+
+// Recover color and alpha of every pixel from the icon rendered on black
+// (on_black) and on white (in place in entry->pixels). Per 2-bit channel:
+// on_black = a * c and on_white = a * c + (1 - a) * 3, so antialiased edges
+// keep their coverage when blitted with GCompOpSet.
+static void resolve_pixels(IconCacheEntry *entry, GBitmap *on_black) {
+  for (int y = 0; y < entry->size.h; y++) {
+    const uint8_t *black_row = gbitmap_get_data(on_black) + y * gbitmap_get_bytes_per_row(on_black);
+    uint8_t *row = gbitmap_get_data(entry->pixels) + y * gbitmap_get_bytes_per_row(entry->pixels);
+    for (int x = 0; x < entry->size.w; x++) {
+      GColor b = (GColor){ .argb = black_row[x] };
+      GColor w = (GColor){ .argb = row[x] };
+      int spread = w.r - b.r;
+      if (w.g - b.g > spread) spread = w.g - b.g;
+      if (w.b - b.b > spread) spread = w.b - b.b;
+      const int alpha = 3 - (spread < 0 ? 0 : spread);
+      if (alpha == 0) {
+        row[x] = GColorClear.argb;
+        continue;
+      }
+      GColor c;
+      c.a = alpha;
+      c.r = unpremultiply(b.r, alpha);
+      c.g = unpremultiply(b.g, alpha);
+      c.b = unpremultiply(b.b, alpha);
+      row[x] = c.argb;
+    }
+  }
+}
+#endif
+
+// Render the icon on a solid background into the framebuffer and copy the
+// pixels out of it. On 1-bit displays the pass on black yields the OR mask
+// of white pixels and the pass on white the AND mask of black pixels;
+// dithered gray survives both.
+static bool render_pass(GContext *ctx, GDrawCommandImage *image, GRect rect,
+                        GRect screen_rect, GColor background, GBitmap *target) {
+  graphics_context_set_fill_color(ctx, background);
+  graphics_fill_rect(ctx, rect, 0, GCornerNone);
+  gdraw_command_image_draw(ctx, image, rect.origin);
+
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return false;
+  }
+  bool ok = bitmap_cache_copy_from_framebuffer(fb, screen_rect, target);
+  graphics_release_frame_buffer(ctx, fb);
+  return ok;
+}
+
+static bool bake(IconCacheEntry *entry, GContext *ctx, Layer *layer, GDrawCommandImage *image, GRect rect) {
+  GRect screen_rect = layer_convert_rect_to_screen(layer, rect);
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return false;
+  }
+  const GBitmapFormat format = gbitmap_get_format(fb);
+
+  // The icon is rendered in place, what is underneath is restored afterwards
+  GBitmap *saved = bitmap_cache_create_bitmap(rect.size, format);
+  bool ok = saved && bitmap_cache_copy_from_framebuffer(fb, screen_rect, saved);
+  graphics_release_frame_buffer(ctx, fb);
+  if (!ok) {
+    if (saved) gbitmap_destroy(saved);
+    return false;
+  }
+
+#if defined(PBL_COLOR)
+  GBitmap *on_black = bitmap_cache_create_bitmap(rect.size, format);
+  entry->pixels = bitmap_cache_create_bitmap(rect.size, format);
+  ok = on_black && entry->pixels &&
+       render_pass(ctx, image, rect, screen_rect, GColorBlack, on_black) &&
+       render_pass(ctx, image, rect, screen_rect, GColorWhite, entry->pixels);
+  if (ok) {
+    resolve_pixels(entry, on_black);
+  }
+  if (on_black) gbitmap_destroy(on_black);
+#else
+  entry->white_mask = bitmap_cache_create_bitmap(rect.size, format);
+  entry->black_mask = bitmap_cache_create_bitmap(rect.size, format);
+  ok = entry->white_mask && entry->black_mask &&
+       render_pass(ctx, image, rect, screen_rect, GColorBlack, entry->white_mask) &&
+       render_pass(ctx, image, rect, screen_rect, GColorWhite, entry->black_mask);
+#endif
+
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+  graphics_draw_bitmap_in_rect(ctx, saved, rect);
+  gbitmap_destroy(saved);
+
+  if (!ok) {
+    free_entry(entry);
+    return false;
+  }
+  entry->valid = true;
+  return true;
+}
+
+// True if the icon is completely visible on screen and inside the area
+// being redrawn, which baking requires
+static bool rect_is_on_screen(Layer *layer, GRect rect) {
+  GRect bounds = layer_get_bounds(layer);
+  if (rect.origin.x < bounds.origin.x || rect.origin.y < bounds.origin.y ||
+      rect.origin.x + rect.size.w > bounds.origin.x + bounds.size.w ||
+      rect.origin.y + rect.size.h > bounds.origin.y + bounds.size.h) {
+    return false;
+  }
+  GRect screen_rect = layer_convert_rect_to_screen(layer, rect);
+  GRect window = layer_get_bounds(window_get_root_layer(layer_get_window(layer)));
+  GRect clip = compositor_clip();
+  return screen_rect.origin.x >= 0 && screen_rect.origin.y >= 0 &&
+         screen_rect.origin.x + screen_rect.size.w <= window.size.w &&
+         screen_rect.origin.y + screen_rect.size.h <= window.size.h &&
+         screen_rect.origin.x >= clip.origin.x && screen_rect.origin.y >= clip.origin.y &&
+         screen_rect.origin.x + screen_rect.size.w <= clip.origin.x + clip.size.w &&
+         screen_rect.origin.y + screen_rect.size.h <= clip.origin.y + clip.size.h;
+}
+
+void icon_cache_draw(GContext *ctx, Layer *layer, GDrawCommandImage *image, uint32_t resource_id, GPoint origin) {
+  if (!image) {
+    return;
+  }
+  const GSize size = gdraw_command_image_get_bounds_size(image);
+  const GRect rect = (GRect){ .origin = origin, .size = size };
+  const bool light = is_light_theme();
+
+  IconCacheEntry *entry = find_entry(resource_id, size, light);
+  if (!entry && rect_is_on_screen(layer, rect)) {
+    // Bake before evicting, so a failed bake keeps the cached icons
+    IconCacheEntry baked = { .resource_id = resource_id, .size = size, .light = light };
+    if (bake(&baked, ctx, layer, image, rect)) {
+      entry = victim_entry();
+      free_entry(entry);
+      *entry = baked;
+    }
+  }
+
+  if (!entry) {
+    gdraw_command_image_draw(ctx, image, origin);
+    return;
+  }
+
+  entry->last_used = ++s_use_counter;
+#if defined(PBL_COLOR)
+  graphics_context_set_compositing_mode(ctx, GCompOpSet);
+  graphics_draw_bitmap_in_rect(ctx, entry->pixels, rect);
+#else
+  graphics_context_set_compositing_mode(ctx, GCompOpOr);
+  graphics_draw_bitmap_in_rect(ctx, entry->white_mask, rect);
+  graphics_context_set_compositing_mode(ctx, GCompOpAnd);
+  graphics_draw_bitmap_in_rect(ctx, entry->black_mask, rect);
+#endif
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+}
+
+void icon_cache_invalidate_all() {
+  for (int i = 0; i < ICON_CACHE_SLOTS; i++) {
+    free_entry(&s_entries[i]);
+  }
+}
+
+void icon_cache_destroy() {
+  icon_cache_invalidate_all();
+  s_use_counter = 0;
+}
@@ -0,0 +1,29 @@
+#ifndef ICON_CACHE_H
+#define ICON_CACHE_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Number of rasterized icons kept at once (6 info icons, 3 forecast icons
+// and one spare for weather changes). The least recently drawn is replaced.
+#define ICON_CACHE_SLOTS 10
+
+/*
+ * Function Declarations
+ */
+
+// Draw a PDC icon at origin (layer coordinates). The first draw renders the
+// vector image once and keeps its pixels, keyed by resource id, icon size and
+// theme; later draws only blit the bitmap. Falls back to drawing the vector
+// image if the icon is not fully on screen or memory is short.
+void icon_cache_draw(GContext *ctx, Layer *layer, GDrawCommandImage *image, uint32_t resource_id, GPoint origin);
+
+// Drop all rasterized icons, e.g. after a theme change
+void icon_cache_invalidate_all();
+
+void icon_cache_destroy();
+
+#endif // ICON_CACHE_H
@@ -0,0 +1,183 @@
+#include "journal.h"
+
+typedef struct {
+  uint32_t key;
+  const void *data;          // Value in RAM, or NULL if built by pack
+  size_t size;
+  JournalPackHandler pack;
+  uint8_t *image;            // Copy of the image last stored under key
+  size_t capacity;
+  size_t image_size;
+  bool stored;               // image holds what is stored under key
+  bool dirty;
+} JournalEntry;
+
+static JournalEntry s_entries[JOURNAL_MAX_ENTRIES];
+static int s_num_entries = 0;
+static uint8_t s_image_pool[JOURNAL_IMAGE_POOL_SIZE];
+static size_t s_image_pool_used = 0;
+static AppTimer *s_flush_timer = NULL;
+
+// Marks, marks of values already waiting, flushed values equal to the
+// stored image (writes avoided) and writes
+static struct {
+  uint32_t marked;
+  uint32_t coalesced;
+  uint32_t unchanged;
+  uint32_t written;
+} s_counters;
+
+static JournalEntry *find_entry(uint32_t key) {
+  for (int i = 0; i < s_num_entries; i++) {
+    if (s_entries[i].key == key) {
+      return &s_entries[i];
+    }
+  }
+  return NULL;
+}
+
+// Re-registering a key keeps its slot and image space, capacity must not grow
+static JournalEntry *add_entry(uint32_t key, size_t capacity) {
+  JournalEntry *entry = find_entry(key);
+  uint8_t *image = NULL;
+  if (entry) {
+    if (capacity > entry->capacity) {
+      APP_LOG(APP_LOG_LEVEL_ERROR, "Journal key %d re-registered larger", (int)key);
+      return NULL;
+    }
+    image = entry->image;
+    capacity = entry->capacity;
+  } else {
+    if (s_num_entries >= JOURNAL_MAX_ENTRIES) {
+      APP_LOG(APP_LOG_LEVEL_ERROR, "Journal full, key %d not registered", (int)key);
+      return NULL;
+    }
+    // Word align the image space
+    const size_t reserved = (capacity + 3) & ~(size_t)3;
+    if (s_image_pool_used + reserved > JOURNAL_IMAGE_POOL_SIZE) {
+      APP_LOG(APP_LOG_LEVEL_ERROR, "Journal pool full, key %d not registered", (int)key);
+      return NULL;
+    }
+    image = &s_image_pool[s_image_pool_used];
+    s_image_pool_used += reserved;
+    entry = &s_entries[s_num_entries++];
+  }
+  memset(entry, 0, sizeof(*entry));
+  entry->key = key;
+  entry->image = image;
+  entry->capacity = capacity;
+  return entry;
+}
+
+// Remember image as what is stored under key
+static void set_stored(JournalEntry *entry, const void *image, size_t size) {
+  if (size > entry->capacity) {
+    entry->stored = false;
+    return;
+  }
+  memcpy(entry->image, image, size);
+  entry->image_size = size;
+  entry->stored = true;
+}
+
+static void flush_timer_callback(void *data) {
+  s_flush_timer = NULL;
+  journal_flush();
+}
+
+static void set_dirty(JournalEntry *entry) {
+  if (entry->dirty) {
+    s_counters.coalesced++;
+    return;
+  }
+  entry->dirty = true;
+  if (!s_flush_timer) {
+    s_flush_timer = app_timer_register(0, flush_timer_callback, NULL);
+  }
+}
+
+void journal_register_data(uint32_t key, const void *data, size_t size, bool persisted) {
+  JournalEntry *entry = add_entry(key, size);
+  if (!entry) {
+    return;
+  }
+  entry->data = data;
+  entry->size = size;
+  if (persisted) {
+    set_stored(entry, data, size);
+  } else {
+    set_dirty(entry);
+  }
+}
+
+void journal_register_packed(uint32_t key, JournalPackHandler pack, size_t capacity,
+                             const void *persisted, size_t size) {
+  JournalEntry *entry = add_entry(key, capacity);
+  if (!entry) {
+    return;
+  }
+  entry->pack = pack;
+  if (persisted) {
+    set_stored(entry, persisted, size);
+  }
+  if (!entry->stored) {
+    set_dirty(entry);
+  }
+}
+
+void journal_mark(uint32_t key) {
+  JournalEntry *entry = find_entry(key);
+  if (!entry) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Journal key %d not registered", (int)key);
+    return;
+  }
+  s_counters.marked++;
+  set_dirty(entry);
+}
+
+void journal_flush() {
+  if (s_flush_timer) {
+    app_timer_cancel(s_flush_timer);
+    s_flush_timer = NULL;
+  }
+
+  // Static: PERSIST_DATA_MAX_LENGTH is 256 bytes, too much for the app stack
+  static uint8_t buffer[PERSIST_DATA_MAX_LENGTH];
+  int written = 0;
+  for (int i = 0; i < s_num_entries; i++) {
+    JournalEntry *entry = &s_entries[i];
+    if (!entry->dirty) {
+      continue;
+    }
+    entry->dirty = false;
+
+    const void *image = entry->data;
+    size_t size = entry->size;
+    if (entry->pack) {
+      size = entry->pack(buffer);
+      image = buffer;
+    }
+    if (entry->stored && entry->image_size == size &&
+        memcmp(entry->image, image, size) == 0) {
+      s_counters.unchanged++;
+      continue;
+    }
+    if (persist_write_data(entry->key, image, size) < 0) {
+      APP_LOG(APP_LOG_LEVEL_ERROR, "Journal write of key %d failed", (int)entry->key);
+      entry->stored = false;
+      continue;
+    }
+    set_stored(entry, image, size);
+    s_counters.written++;
+    written++;
+  }
+  if (written > 0) {
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Journal flushed, %d values written", written);
+  }
+}
+
+void journal_log() {
+  APP_LOG(APP_LOG_LEVEL_INFO, "Journal: %d marks, %d coalesced, %d unchanged, %d written",
+          (int)s_counters.marked, (int)s_counters.coalesced,
+          (int)s_counters.unchanged, (int)s_counters.written);
+}
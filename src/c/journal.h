@@ -0,0 +1,49 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Write-behind for the persisted values. Changed values are only marked;
+// they are written once at the next idle point (a zero delay timer, after
+// the current event) or when the app closes, and only if they differ from
+// what is already stored. A copy of the stored image is kept in RAM, so
+// nothing is read back from flash.
+
+// Persisted values known to the journal
+#define JOURNAL_MAX_ENTRIES 8
+
+// Bytes for the copies of the stored images (settings 26, weather 31,
+// forecast 24 + 2 * 96, flags 2 * 1, each word aligned)
+#define JOURNAL_IMAGE_POOL_SIZE 320
+
+// Fill buffer (PERSIST_DATA_MAX_LENGTH bytes) with the image to persist,
+// return its size
+typedef size_t (*JournalPackHandler)(void *buffer);
+
+/*
+ * Function Declarations
+ */
+
+// Persisted value kept as is in RAM at data. persisted: data holds what is
+// stored under key (it was just loaded), otherwise the next flush writes it.
+void journal_register_data(uint32_t key, const void *data, size_t size, bool persisted);
+
+// Persisted value built by pack, at most capacity bytes. persisted holds the
+// stored bytes (size of them), NULL if nothing is stored under key yet.
+void journal_register_packed(uint32_t key, JournalPackHandler pack, size_t capacity,
+                             const void *persisted, size_t size);
+
+// The value of key changed in RAM, write it behind
+void journal_mark(uint32_t key);
+
+// Write the marked values that differ from their stored image now
+void journal_flush();
+
+// Log the write counters (marks, coalesced marks, unchanged, written)
+void journal_log();
+
+#endif // JOURNAL_H
@@ -0,0 +1,129 @@
+#include "memstats.h"
+#include "arena.h"
+
+#if defined(PBL_PLATFORM_APLITE)
+  #define MEMSTATS_PLATFORM "aplite"
+#elif defined(PBL_PLATFORM_BASALT)
+  #define MEMSTATS_PLATFORM "basalt"
+#elif defined(PBL_PLATFORM_DIORITE)
+  #define MEMSTATS_PLATFORM "diorite"
+#elif defined(PBL_PLATFORM_EMERY)
+  #define MEMSTATS_PLATFORM "emery"
+#else
+  #define MEMSTATS_PLATFORM "unknown"
+#endif
+
+typedef struct {
+  uint32_t max_used;
+  uint32_t min_free;
+} HeapMark;
+
+static const char *s_point_names[NUM_MEMSTATS_POINTS] = {
+  [MEMSTATS_INIT] = "init",
+  [MEMSTATS_WINDOW_LOAD] = "load",
+  [MEMSTATS_REBUILD] = "rebuild",
+  [MEMSTATS_THEME] = "theme",
+  [MEMSTATS_FORECAST] = "forecast"
+};
+
+static const char *s_subsystem_names[NUM_MEMSTATS_SUBSYSTEMS] = {
+  [MEMSTATS_ICONS] = "icons",
+  [MEMSTATS_BITMAPS] = "bitmaps"
+};
+
+// min_free of 0 marks a point that was never sampled
+static HeapMark s_peak;
+static HeapMark s_points[NUM_MEMSTATS_POINTS];
+static struct {
+  uint32_t count;
+  uint32_t bytes;
+} s_subsystems[NUM_MEMSTATS_SUBSYSTEMS];
+
+// Stack high-water mark: bytes below the painted range's top that still hold
+// the pattern were never reached. The margin keeps the painting function's
+// own frame out of the range.
+#define STACK_PATTERN 0xA5
+#define STACK_MARGIN 64
+static uintptr_t s_stack_low;
+
+static void update_mark(HeapMark *mark, uint32_t used, uint32_t free) {
+  if (used > mark->max_used) {
+    mark->max_used = used;
+  }
+  if (mark->min_free == 0 || free < mark->min_free) {
+    mark->min_free = free;
+  }
+}
+
+void memstats_record(MemstatsPoint point) {
+  const uint32_t used = heap_bytes_used();
+  const uint32_t free = heap_bytes_free();
+  update_mark(&s_points[point], used, free);
+  update_mark(&s_peak, used, free);
+}
+
+void __attribute__((noinline)) memstats_paint_stack() {
+  uint8_t marker;
+  const uintptr_t top = (uintptr_t)&marker - STACK_MARGIN;
+  s_stack_low = top - MEMSTATS_STACK_PAINT;
+  for (volatile uint8_t *p = (volatile uint8_t *)s_stack_low; (uintptr_t)p < top; p++) {
+    *p = STACK_PATTERN;
+  }
+}
+
+static int stack_used() {
+  if (s_stack_low == 0) {
+    return 0;
+  }
+  const volatile uint8_t *painted = (const volatile uint8_t *)s_stack_low;
+  int untouched = 0;
+  while (untouched < MEMSTATS_STACK_PAINT && painted[untouched] == STACK_PATTERN) {
+    untouched++;
+  }
+  return MEMSTATS_STACK_PAINT - untouched;
+}
+
+void memstats_count(MemstatsSubsystem subsystem, size_t bytes) {
+  s_subsystems[subsystem].count++;
+  s_subsystems[subsystem].bytes += bytes;
+}
+
+void memstats_format(char *buffer, size_t size) {
+  int length = snprintf(buffer, size, "memstats %s peak=%d/%d", MEMSTATS_PLATFORM,
+                        (int)s_peak.max_used, (int)s_peak.min_free);
+  for (int i = 0; i < NUM_MEMSTATS_POINTS && length < (int)size; i++) {
+    length += snprintf(buffer + length, size - length, " %s=%d/%d", s_point_names[i],
+                       (int)s_points[i].max_used, (int)s_points[i].min_free);
+  }
+  for (int i = 0; i < NUM_MEMSTATS_SUBSYSTEMS && length < (int)size; i++) {
+    length += snprintf(buffer + length, size - length, " %s=%d/%d", s_subsystem_names[i],
+                       (int)s_subsystems[i].count, (int)s_subsystems[i].bytes);
+  }
+  if (length < (int)size) {
+    length += snprintf(buffer + length, size - length, " arena=%d/%d",
+                       (int)arena_used(), (int)arena_peak());
+  }
+  if (length < (int)size) {
+    snprintf(buffer + length, size - length, " stack=%d/%d", stack_used(), MEMSTATS_STACK_PAINT);
+  }
+}
+
+void memstats_log() {
+  char report[MEMSTATS_REPORT_SIZE];
+  memstats_format(report, sizeof(report));
+  APP_LOG(APP_LOG_LEVEL_INFO, "%s", report);
+}
+
+void memstats_send(uint32_t key) {
+  char report[MEMSTATS_REPORT_SIZE];
+  memstats_format(report, sizeof(report));
+
+  DictionaryIterator *iter;
+  app_message_outbox_begin(&iter);
+  if (iter == NULL) {
+    APP_LOG(APP_LOG_LEVEL_ERROR, "Failed to send memstats");
+    return;
+  }
+  dict_write_cstring(iter, key, report);
+  app_message_outbox_send();
+}
@@ -0,0 +1,60 @@
+#ifndef MEMSTATS_H
+#define MEMSTATS_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Points where the heap is sampled. Each keeps the highest heap use and
+// the lowest free heap seen there.
+typedef enum {
+  MEMSTATS_INIT = 0,      // End of init
+  MEMSTATS_WINDOW_LOAD,   // End of main_window_load
+  MEMSTATS_REBUILD,       // Info slots rebuilt
+  MEMSTATS_THEME,         // Theme switched
+  MEMSTATS_FORECAST,      // Forecast panels shown
+  NUM_MEMSTATS_POINTS
+} MemstatsPoint;
+
+// Subsystems that count their allocations (number and bytes)
+typedef enum {
+  MEMSTATS_ICONS = 0,     // PDC icons (window arena)
+  MEMSTATS_BITMAPS,       // Offscreen bitmaps (caches, atlas, snapshots)
+  NUM_MEMSTATS_SUBSYSTEMS
+} MemstatsSubsystem;
+
+// Longest report, see memstats_format
+#define MEMSTATS_REPORT_SIZE 256
+
+// Bytes of stack painted below main() for the high-water mark. The app stack
+// is only a few KB (2 KB on aplite), so keep this well inside it.
+#define MEMSTATS_STACK_PAINT 1024
+
+/*
+ * Function Declarations
+ */
+
+// Paint the unused stack below the caller with a guard pattern. Call first
+// thing in main(); the report then counts how much of it was overwritten.
+void memstats_paint_stack();
+
+// Sample the heap at point
+void memstats_record(MemstatsPoint point);
+
+// Count an allocation of bytes by subsystem
+void memstats_count(MemstatsSubsystem subsystem, size_t bytes);
+
+// One line report, read by tools/memstats_report.py:
+// "memstats <platform> peak=<used>/<free> <point>=<used>/<free>... <subsystem>=<count>/<bytes>...
+//  arena=<used>/<peak> stack=<used>/<painted>"
+void memstats_format(char *buffer, size_t size);
+
+// Log the report (end of the session)
+void memstats_log();
+
+// Reply to a debug request with the report under key
+void memstats_send(uint32_t key);
+
+#endif // MEMSTATS_H
@@ -0,0 +1,243 @@
+#include "outline_text.h"
+#include "compositor.h"
+
+// Pixels around the text box that are scanned for text and outline pixels
+#define OUTLINE_PAD 2
+
+// Text pixel mask of the region. Words are aligned to screen columns
+// (word 0 covers the columns first_word * 32 .. first_word * 32 + 31) so the
+// 1-bit framebuffer can be read and written with whole word operations.
+static uint32_t s_mask[OUTLINE_TEXT_MAX_ROWS][OUTLINE_TEXT_MAX_WORDS];
+#if defined(PBL_BW)
+// Original framebuffer bits of the region while the text is rasterized
+static uint32_t s_saved[OUTLINE_TEXT_MAX_ROWS][OUTLINE_TEXT_MAX_WORDS];
+#endif
+
+typedef struct {
+  int x0, x1;       // screen columns [x0, x1)
+  int y0, y1;       // screen rows [y0, y1)
+  int first_word;   // x0 / 32
+  int num_words;
+} Region;
+
+// Fallback for text that does not fit the mask: four offset copies in the
+// outline color, then the text itself
+static void draw_text_five_times(GContext *ctx, const char *text, GFont font, GRect rect,
+                                 GTextOverflowMode overflow, GTextAlignment alignment,
+                                 GColor fg_color, GColor outline_color) {
+  graphics_context_set_text_color(ctx, outline_color);
+  graphics_draw_text(ctx, text, font, GRect(rect.origin.x - 1, rect.origin.y, rect.size.w, rect.size.h), overflow, alignment, NULL);
+  graphics_draw_text(ctx, text, font, GRect(rect.origin.x + 1, rect.origin.y, rect.size.w, rect.size.h), overflow, alignment, NULL);
+  graphics_draw_text(ctx, text, font, GRect(rect.origin.x, rect.origin.y - 1, rect.size.w, rect.size.h), overflow, alignment, NULL);
+  graphics_draw_text(ctx, text, font, GRect(rect.origin.x, rect.origin.y + 1, rect.size.w, rect.size.h), overflow, alignment, NULL);
+  graphics_context_set_text_color(ctx, fg_color);
+  graphics_draw_text(ctx, text, font, rect, overflow, alignment, NULL);
+}
+
+// Screen region that can contain text or outline pixels, clipped to the
+// layer and the screen. Returns false if it is too large for the mask or
+// only partly inside the area being redrawn.
+static bool compute_region(Layer *layer, const char *text, GFont font, GRect rect,
+                           GTextOverflowMode overflow, GTextAlignment alignment,
+                           GRect fb_bounds, Region *region) {
+  // Narrow the box down to the text itself
+  GSize content = graphics_text_layout_get_content_size(text, font, rect, overflow, alignment);
+  GRect area = rect;
+  if (content.w < rect.size.w) {
+    if (alignment == GTextAlignmentCenter) {
+      area.origin.x += (rect.size.w - content.w) / 2;
+    } else if (alignment == GTextAlignmentRight) {
+      area.origin.x += rect.size.w - content.w;
+    }
+    area.size.w = content.w;
+  }
+  if (content.h < rect.size.h) {
+    area.size.h = content.h;
+  }
+  area = GRect(area.origin.x - OUTLINE_PAD, area.origin.y - OUTLINE_PAD,
+               area.size.w + 2 * OUTLINE_PAD, area.size.h + 2 * OUTLINE_PAD);
+
+  GRect screen = layer_convert_rect_to_screen(layer, area);
+  GRect visible = layer_convert_rect_to_screen(layer, layer_get_bounds(layer));
+
+  // Text cut by the area being redrawn has outline pixels whose text pixels
+  // are not drawn, those are left to the plain draws
+  GRect on_screen = screen;
+  grect_clip(&on_screen, &fb_bounds);
+  GRect clip = compositor_clip();
+  if (on_screen.origin.x < clip.origin.x || on_screen.origin.y < clip.origin.y ||
+      on_screen.origin.x + on_screen.size.w > clip.origin.x + clip.size.w ||
+      on_screen.origin.y + on_screen.size.h > clip.origin.y + clip.size.h) {
+    return false;
+  }
+  region->x0 = screen.origin.x;
+  region->y0 = screen.origin.y;
+  region->x1 = screen.origin.x + screen.size.w;
+  region->y1 = screen.origin.y + screen.size.h;
+  if (region->x0 < visible.origin.x) region->x0 = visible.origin.x;
+  if (region->y0 < visible.origin.y) region->y0 = visible.origin.y;
+  if (region->x1 > visible.origin.x + visible.size.w) region->x1 = visible.origin.x + visible.size.w;
+  if (region->y1 > visible.origin.y + visible.size.h) region->y1 = visible.origin.y + visible.size.h;
+  if (region->x0 < 0) region->x0 = 0;
+  if (region->y0 < 0) region->y0 = 0;
+  if (region->x1 > fb_bounds.size.w) region->x1 = fb_bounds.size.w;
+  if (region->y1 > fb_bounds.size.h) region->y1 = fb_bounds.size.h;
+  if (region->x0 >= region->x1 || region->y0 >= region->y1) {
+    region->num_words = 0;
+    return true;
+  }
+
+  region->first_word = region->x0 / 32;
+  region->num_words = (region->x1 - 1) / 32 - region->first_word + 1;
+  return region->num_words <= OUTLINE_TEXT_MAX_WORDS &&
+         region->y1 - region->y0 <= OUTLINE_TEXT_MAX_ROWS;
+}
+
+// Bits of word w that belong to the region
+static uint32_t region_word_mask(const Region *region, int w) {
+  const int x = (region->first_word + w) * 32;
+  uint32_t m = 0xFFFFFFFF;
+  if (region->x0 > x) m &= 0xFFFFFFFFu << (region->x0 - x);
+  if (region->x1 < x + 32) m &= 0xFFFFFFFFu >> (x + 32 - region->x1);
+  return m;
+}
+
+#if defined(PBL_BW)
+// The 1-bit framebuffer rows are word aligned, pixels are LSB first
+static uint32_t *fb_word(GBitmap *fb, const Region *region, int y, int w) {
+  uint8_t *row = gbitmap_get_data(fb) + y * gbitmap_get_bytes_per_row(fb);
+  return (uint32_t *)row + region->first_word + w;
+}
+
+// Render the text white on a cleared region and read the bits back
+static bool rasterize_mask(GContext *ctx, const char *text, GFont font, GRect rect,
+                           GTextOverflowMode overflow, GTextAlignment alignment, const Region *region) {
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return false;
+  }
+  for (int y = region->y0; y < region->y1; y++) {
+    for (int w = 0; w < region->num_words; w++) {
+      uint32_t *word = fb_word(fb, region, y, w);
+      s_saved[y - region->y0][w] = *word;
+      *word &= ~region_word_mask(region, w);
+    }
+  }
+  graphics_release_frame_buffer(ctx, fb);
+
+  graphics_context_set_text_color(ctx, GColorWhite);
+  graphics_draw_text(ctx, text, font, rect, overflow, alignment, NULL);
+
+  fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return false;
+  }
+  for (int y = region->y0; y < region->y1; y++) {
+    for (int w = 0; w < region->num_words; w++) {
+      uint32_t *word = fb_word(fb, region, y, w);
+      const uint32_t m = region_word_mask(region, w);
+      s_mask[y - region->y0][w] = *word & m;
+      *word = (*word & ~m) | (s_saved[y - region->y0][w] & m);
+    }
+  }
+  graphics_release_frame_buffer(ctx, fb);
+  return true;
+}
+#else
+// Render the text in the sentinel color and collect those pixels
+static bool rasterize_mask(GContext *ctx, const char *text, GFont font, GRect rect,
+                           GTextOverflowMode overflow, GTextAlignment alignment, const Region *region) {
+  graphics_context_set_text_color(ctx, OUTLINE_TEXT_SENTINEL);
+  graphics_draw_text(ctx, text, font, rect, overflow, alignment, NULL);
+
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return false;
+  }
+  const uint8_t sentinel = OUTLINE_TEXT_SENTINEL.argb;
+  for (int y = region->y0; y < region->y1; y++) {
+    const uint8_t *row = gbitmap_get_data(fb) + y * gbitmap_get_bytes_per_row(fb);
+    uint32_t *mask_row = s_mask[y - region->y0];
+    memset(mask_row, 0, sizeof(s_mask[0]));
+    for (int x = region->x0; x < region->x1; x++) {
+      if (row[x] == sentinel) {
+        const int bit = x - region->first_word * 32;
+        mask_row[bit / 32] |= 1u << (bit % 32);
+      }
+    }
+  }
+  graphics_release_frame_buffer(ctx, fb);
+  return true;
+}
+#endif
+
+// Outline of row r: the text pixels of the row shifted left and right and
+// the rows above and below, minus the text itself
+static uint32_t dilate_word(const Region *region, int r, int w) {
+  const int rows = region->y1 - region->y0;
+  const uint32_t *row = s_mask[r];
+  uint32_t d = (row[w] << 1) | (row[w] >> 1);
+  if (w > 0) d |= row[w - 1] >> 31;
+  if (w + 1 < region->num_words) d |= row[w + 1] << 31;
+  if (r > 0) d |= s_mask[r - 1][w];
+  if (r + 1 < rows) d |= s_mask[r + 1][w];
+  return d & ~row[w] & region_word_mask(region, w);
+}
+
+static void composite(GContext *ctx, const Region *region, GColor fg_color, GColor outline_color) {
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return;
+  }
+  for (int y = region->y0; y < region->y1; y++) {
+    const int r = y - region->y0;
+    for (int w = 0; w < region->num_words; w++) {
+      const uint32_t text = s_mask[r][w];
+      const uint32_t outline = dilate_word(region, r, w);
+#if defined(PBL_BW)
+      // Both masks are applied to the framebuffer word at once
+      const uint32_t fg = gcolor_equal(fg_color, GColorWhite) ? 0xFFFFFFFF : 0;
+      const uint32_t ol = gcolor_equal(outline_color, GColorWhite) ? 0xFFFFFFFF : 0;
+      uint32_t *word = fb_word(fb, region, y, w);
+      *word = (*word & ~(text | outline)) | (fg & text) | (ol & outline);
+#else
+      uint8_t *row = gbitmap_get_data(fb) + y * gbitmap_get_bytes_per_row(fb) + (region->first_word + w) * 32;
+      uint32_t bits = text | outline;
+      while (bits) {
+        const int bit = __builtin_ctz(bits);
+        row[bit] = (text & (1u << bit)) ? fg_color.argb : outline_color.argb;
+        bits &= bits - 1;
+      }
+#endif
+    }
+  }
+  graphics_release_frame_buffer(ctx, fb);
+}
+
+void outline_text_draw(GContext *ctx, Layer *layer, const char *text, GFont font, GRect rect,
+                       GTextOverflowMode overflow, GTextAlignment alignment,
+                       GColor fg_color, GColor outline_color) {
+  if (!text || !text[0]) {
+    return;
+  }
+
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return;
+  }
+  GRect fb_bounds = gbitmap_get_bounds(fb);
+  graphics_release_frame_buffer(ctx, fb);
+
+  Region region;
+  if (!compute_region(layer, text, font, rect, overflow, alignment, fb_bounds, &region)) {
+    draw_text_five_times(ctx, text, font, rect, overflow, alignment, fg_color, outline_color);
+    return;
+  }
+  if (region.num_words == 0) {
+    return;
+  }
+
+  if (rasterize_mask(ctx, text, font, rect, overflow, alignment, &region)) {
+    composite(ctx, &region, fg_color, outline_color);
+  }
+}
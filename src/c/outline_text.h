@@ -0,0 +1,32 @@
+#ifndef OUTLINE_TEXT_H
+#define OUTLINE_TEXT_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Largest text area (plus outline) handled by the mask renderer. Bigger
+// labels fall back to drawing the text five times.
+#define OUTLINE_TEXT_MAX_WORDS 4    // 32 pixel columns per word
+#define OUTLINE_TEXT_MAX_ROWS 32
+
+// Color used to find the rendered text pixels on color displays. It must
+// not appear anywhere else on the watch face.
+#define OUTLINE_TEXT_SENTINEL GColorMagenta
+
+/*
+ * Function Declarations
+ */
+
+// Draw text with a 1px outline. The text is rasterized once, the outline is
+// derived from its pixel mask with a 4-neighbour dilation (shift and OR on
+// whole words) and both are written into the framebuffer in one pass. Looks
+// exactly like drawing the text at the four 1px offsets in the outline
+// color and once more in the center.
+void outline_text_draw(GContext *ctx, Layer *layer, const char *text, GFont font, GRect rect,
+                       GTextOverflowMode overflow, GTextAlignment alignment,
+                       GColor fg_color, GColor outline_color);
+
+#endif // OUTLINE_TEXT_H
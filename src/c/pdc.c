@@ -0,0 +1,47 @@
+#include "pdc.h"
+
+// Image: version, reserved, view box (2 x int16), number of commands
+#define PDC_IMAGE_HEADER_SIZE 8
+// Command: type, hidden, stroke color, stroke width, fill color,
+// path open or radius (uint16), number of points (uint16)
+#define PDC_COMMAND_HEADER_SIZE 9
+#define PDC_POINT_SIZE 4
+
+static int read_u16(const uint8_t *bytes) {
+  return bytes[0] | (bytes[1] << 8);
+}
+
+int pdc_image_size(const uint8_t *header, size_t resource_size) {
+  if (resource_size <= PDC_HEADER_SIZE || memcmp(header, "PDCI", 4) != 0) {
+    return -1;
+  }
+  const uint32_t size = header[4] | (header[5] << 8) | (header[6] << 16) |
+                        ((uint32_t)header[7] << 24);
+  return size == resource_size - PDC_HEADER_SIZE ? (int)size : -1;
+}
+
+bool pdc_parse(const uint8_t *image, size_t size, PdcInfo *info) {
+  if (size < PDC_IMAGE_HEADER_SIZE || image[0] != 1) {
+    return false;
+  }
+  const int num_commands = read_u16(image + 6);
+  size_t offset = PDC_IMAGE_HEADER_SIZE;
+  for (int i = 0; i < num_commands; i++) {
+    if (offset + PDC_COMMAND_HEADER_SIZE > size) {
+      return false;
+    }
+    const int type = image[offset];
+    if (type < 1 || type > 3) {
+      // Path, circle or precise path
+      return false;
+    }
+    offset += PDC_COMMAND_HEADER_SIZE + read_u16(image + offset + 7) * PDC_POINT_SIZE;
+  }
+  if (offset != size) {
+    return false;
+  }
+  info->width = (int16_t)read_u16(image + 2);
+  info->height = (int16_t)read_u16(image + 4);
+  info->num_commands = num_commands;
+  return true;
+}
@@ -0,0 +1,33 @@
+#ifndef PDC_H
+#define PDC_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// PDC files (Pebble Draw Command) start with the magic "PDCI" and the size
+// of the image data that follows
+#define PDC_HEADER_SIZE 8
+
+// What an image declares in its serialized form
+typedef struct {
+  int width;          // View box
+  int height;
+  int num_commands;
+} PdcInfo;
+
+/*
+ * Function Declarations
+ */
+
+// Size of the image data after header, -1 if header is not the header of
+// a PDC file of resource_size bytes
+int pdc_image_size(const uint8_t *header, size_t resource_size);
+
+// Walk the image data (version 1, view box, command list) and check that
+// the commands end exactly at size. Fills info if the image is valid.
+bool pdc_parse(const uint8_t *image, size_t size, PdcInfo *info);
+
+#endif // PDC_H
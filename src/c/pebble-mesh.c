@@ -7,7 +7,21 @@
 #include "calendar.h"
 #include "disconnect.h"
 #include "heart_rate.h"
+#include "widget.h"
+#include "store.h"
+#include "deferred.h"
 #include "weather_forecast.h"
+#include "bitmap_cache.h"
+#include "raster.h"
+#include "glyph_atlas.h"
+#include "outline_text.h"
+#include "icon_cache.h"
+#include "fixed.h"
+#include "timeline.h"
+#include "compositor.h"
+#include "arena.h"
+#include "memstats.h"
+#include "journal.h"
 
 
 
@@ -17,84 +31,129 @@ static Layer *s_time_layer;
 static Layer *s_date_layer;
 static Layer *s_frame_layer;
 static Layer *s_animation_layer;
+static Layer *s_scene_layer;
+#if defined(FLAT_RENDER)
+// Draws all of the above, the element layer pointers all refer to it
+static Layer *s_face_layer;
+#endif
+
+// Time and date text boxes in the coordinates of the layer drawing them
+static GRect s_time_bounds;
+static GRect s_date_bounds;
 
-// Pointer for the animation AppTimer
-#define GRID_SIZE 8
-#define CROSS_SIZE 0
+// Seconds tick: the second subscription is only active while the tick is
+// shown, which needs the setting, the focus and no forecast panels
+static TimeUnits s_tick_units = 0;
+static bool s_app_focused = true;
+static bool s_forecast_up = false;
+static int s_seconds = -1; // Second the tick is drawn at, -1 = no tick
 
+// Intro animation: NUM_ANIMATION_FRAMES frames, played in steps of
+// FRAMES_PER_STEP every ANIMATION_RATE_MS after an initial delay
 #define VERY_FIRST_ANIMATION_FRAME 500
-#define DECREASE_PER_FRAME 10
+#define FRAMES_PER_STEP 10
 #define ANIMATION_RATE_MS 50
 
 #define NUM_ANIMATION_FRAMES 500
+#define NUM_ANIMATION_PHASES 4
+
+// Elapsed frames at the end of each animation phase: time (25%), date (40%),
+// upper line (70%), then the lower line until the end
+#define PHASE_TIME_END (NUM_ANIMATION_FRAMES * 25 / 100)
+#define PHASE_DATE_END (NUM_ANIMATION_FRAMES * 40 / 100)
+#define PHASE_UPPER_LINE_END (NUM_ANIMATION_FRAMES * 70 / 100)
+
+// Typed lines: segments with gaps and a blinking cursor
+#define LINE_SEGMENT_LENGTH 12
+#define LINE_SEGMENT_GAP 2
+#define LINE_CURSOR_BLINK_FRAMES 6
+
+// The lines and the light theme box span 80% of the width
+#define LINE_LENGTH_FACTOR FIXED_FRAC(4, 5)
 
 #define BORDER_THICKNESS 3
 
+#define TIME_FONT FONT_KEY_LECO_42_NUMBERS
+
 // Double-flick detection for weather detail screen
 #define DOUBLE_FLICK_WINDOW_MS 1500
 
 static uint32_t s_last_tap_time = 0;
 
 // Animation
-static AppTimer *s_animation_timer = NULL;
-static int current_animation_frame = 0; // Ranges from NUM_ANIMATION_FRAMES down to 0
-static bool s_last_was_dark = false;
+static TimelinePhase s_animation_phases[NUM_ANIMATION_PHASES];
 static int s_last_connected = -1; // -1 = unknown (init), 0 = disconnected, 1 = connected
 static bool s_is_vibrating = false;
 
+// Pre-rendered frame layer (border, light theme box, mesh)
+static BitmapCache s_frame_cache;
+
 // Buffer to hold the time string (e.g., "12:34" or "23:59")
 static char s_time_buffer[9];
 static char s_date_buffer[20];
 
 // Forward declarations
 static void update_time();
+static void format_time();
+static void commit_message();
 static void battery_handler(BatteryChargeState state);
 static void tick_handler(struct tm *tick_time, TimeUnits units_changed);
-static void animation_timer_callback(void *data);
-static void try_start_animation_timer();
-static void try_stop_animation_timer();
+static void try_start_animation();
+static void try_stop_animation();
+static void init_animation_timeline();
 static void draw_frame(Layer *layer, GContext *ctx);
 static void draw_animation(Layer *layer, GContext *ctx);
+#if defined(FLAT_RENDER)
+static void draw_face(Layer *layer, GContext *ctx);
+#else
 static void draw_time(Layer *layer, GContext *ctx);
 static void draw_date(Layer *layer, GContext *ctx);
+static void draw_info_layer(Layer *layer, GContext *ctx);
+#endif
 static void inbox_received_callback(DictionaryIterator *iterator, void *context);
 static void delayed_weather_request(void *data);
-static void init_info_layers(GRect bounds);
-static void update_all_info_layers();
-static void draw_info_for_type(InfoType info_type, InfoLayer* info_layer);
-static void clear_info_layer(InfoLayer* info_layer);
+static void init_info_layers();
+static int update_all_info_layers();
+static int store_changed(uint32_t changed);
+static void store_layout();
 static void bluetooth_connection_handler(bool connected);
 static void tap_handler(AccelAxisType axis, int32_t direction);
+static void update_seconds_mode();
 
 
 // Function to update all colors based on current theme
 static void update_colors() {
-  window_set_background_color(s_main_window, get_background_color());
-
-  layer_mark_dirty(s_time_layer);
-  layer_mark_dirty(s_date_layer);
+  // Nothing to do if the effective theme did not change
+  if (!theme_refresh()) {
+    return;
+  }
 
-  // Recreate PDC icons for new theme
-  load_weather_icon();
-  load_step_icon();
-  load_calendar_icon();
-  load_battery_icon();
-  load_disconnect_icon();
-  load_heart_icon();
+  // Swap black and white in the loaded PDC icons for the new theme
+  icon_cache_invalidate_all();
+  update_pdc_icon_colors();
 
   // Update all info layers to refresh the display
-  update_all_info_layers();
+  deferred_request(DEFERRED_REBUILD_SLOTS);
 
   // Force redraw
-  layer_mark_dirty(s_frame_layer);
-  layer_mark_dirty(s_animation_layer);
+  compositor_mark_all_dirty();
+  memstats_record(MEMSTATS_THEME);
 }
 
 // --- Weather Functions ---
 static void inbox_received_callback(DictionaryIterator *iterator, void *context) {
   APP_LOG(APP_LOG_LEVEL_DEBUG, "Message received");
+
+  // Theme, slot, icon and time updates asked for below run once at the end
+  deferred_begin();
   
   bool weather_data_updated = false;
+  bool settings_updated = false;
+
+  // Debug request for the memory report
+  if (dict_find(iterator, MESSAGE_KEY_MEMSTATS)) {
+    memstats_send(MESSAGE_KEY_MEMSTATS);
+  }
 
   // Read temperature unit first to know what symbol to use
   Tuple *temp_unit_tuple = dict_find(iterator, MESSAGE_KEY_TEMPERATURE_UNIT);
@@ -102,7 +161,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_unit = (int)temp_unit_tuple->value->int32;
     if (new_unit != s_temperature_unit) {
       s_temperature_unit = new_unit;
-      save_temperature_unit_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Temperature unit changed to: %d", s_temperature_unit);
       weather_data_updated = true;
     }
@@ -113,6 +172,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
   if (temperature_tuple) {
     const char* unit_symbol = s_temperature_unit == 1 ? "°F" : "°C";
     snprintf(s_temperature_buffer, sizeof(s_temperature_buffer), "%s%s", temperature_tuple->value->cstring, unit_symbol);
+    store_set_string(STORE_TEMPERATURE, s_temperature_buffer);
     APP_LOG(APP_LOG_LEVEL_DEBUG, "Temperature: %s", s_temperature_buffer);
     weather_data_updated = true;
   }
@@ -121,6 +181,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
   Tuple *location_tuple = dict_find(iterator, MESSAGE_KEY_WEATHER_LOCATION);
   if (location_tuple) {
     snprintf(s_location_buffer, sizeof(s_location_buffer), "%s", location_tuple->value->cstring);
+    store_set_string(STORE_LOCATION, s_location_buffer);
     APP_LOG(APP_LOG_LEVEL_DEBUG, "Location: %s", s_location_buffer);
     weather_data_updated = true;
   }
@@ -129,8 +190,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
   Tuple *condition_tuple = dict_find(iterator, MESSAGE_KEY_WEATHER_CONDITION);
   if (condition_tuple) {
     s_current_weather_code = (int)condition_tuple->value->int32;
-    // Recreate weather icon with new weather code
-    load_weather_icon();
+    store_set_int(STORE_CONDITION, s_current_weather_code);
     APP_LOG(APP_LOG_LEVEL_DEBUG, "Weather condition: %d", s_current_weather_code);
     weather_data_updated = true;
   }
@@ -138,11 +198,13 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
   // Read is_day
   Tuple *is_day_tuple = dict_find(iterator, MESSAGE_KEY_WEATHER_IS_DAY);
   if (is_day_tuple) {
-    s_is_day = (int)is_day_tuple->value->int32;
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Is day: %d", s_is_day);
+    int new_is_day = (int)is_day_tuple->value->int32;
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Is day: %d", new_is_day);
+    s_is_day = new_is_day;
+    store_set_int(STORE_IS_DAY, s_is_day);
     
     // In case lets update the background colors (dynamic day/night theme)
-    update_colors();
+    deferred_request(DEFERRED_RETHEME);
   }
 
   // Read color theme
@@ -151,9 +213,9 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_theme = (int)theme_tuple->value->int32;
     if (new_theme != s_color_theme) {
       s_color_theme = new_theme;
-      save_theme_to_storage(); // Save the new theme preference
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Color theme changed to: %d", s_color_theme);
-      update_colors();
+      deferred_request(DEFERRED_RETHEME);
     }
   }
 
@@ -163,18 +225,15 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_step_goal = (int)step_goal_tuple->value->int32;
     if (new_step_goal > 0 && new_step_goal != s_step_goal) {
       s_step_goal = new_step_goal;
-      save_step_goal_to_storage(); // Save the new step goal preference
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Step goal changed to: %d", s_step_goal);
-      // Redraw steps info layer to update the progress bar
-      update_all_info_layers();
+      store_set_int(STORE_STEP_GOAL, s_step_goal);
     }
   }
   
   // Save weather data to persistent storage if any was updated
   if (weather_data_updated) {
     save_weather_to_storage();
-    // Redraw all info layers to show updated weather data
-    update_all_info_layers();
   }
 
   // Read forecast data (now, +1d, +2d)
@@ -191,7 +250,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
   if (fc_cond2) s_forecast[1].condition_code = (int)fc_cond2->value->int32;
   if (fc_cond3) s_forecast[2].condition_code = (int)fc_cond3->value->int32;
   if (fc_temp1 || fc_cond1) {
-    weather_forecast_update_icons();
+    deferred_request(DEFERRED_FORECAST_ICONS);
     APP_LOG(APP_LOG_LEVEL_DEBUG, "Forecast updated: %d/%d %d/%d %d/%d",
             s_forecast[0].temperature, s_forecast[0].condition_code,
             s_forecast[1].temperature, s_forecast[1].condition_code,
@@ -216,8 +275,8 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_enable_animations = (int)enable_animations_tuple->value->int32;
     if (new_enable_animations != s_enable_animations) {
       s_enable_animations = new_enable_animations;
-      save_enable_animations_to_storage();
-      try_start_animation_timer();
+      settings_updated = true;
+      try_start_animation();
     }
   }
 
@@ -227,7 +286,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_duration = (int)forecast_duration_tuple->value->int32;
     if (new_duration != s_weather_forecast_duration) {
       s_weather_forecast_duration = new_duration;
-      save_weather_forecast_duration_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Weather forecast duration changed to: %d", s_weather_forecast_duration);
     }
   }
@@ -238,7 +297,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_flick_mode = (int)flick_mode_tuple->value->int32;
     if (new_flick_mode != s_weather_forecast_flick_mode) {
       s_weather_forecast_flick_mode = new_flick_mode;
-      save_weather_forecast_flick_mode_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Weather forecast flick mode changed to: %d", s_weather_forecast_flick_mode);
     }
   }
@@ -249,9 +308,9 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     const char *new_fmt = date_format_tuple->value->cstring;
     if (strcmp(new_fmt, s_date_format) != 0) {
       snprintf(s_date_format, sizeof(s_date_format), "%s", new_fmt);
-      save_date_format_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Date format changed to: %s", s_date_format);
-      update_time();
+      deferred_request(DEFERRED_RETIME);
     }
   }
 
@@ -261,9 +320,9 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_enable_mesh = (int)enable_mesh_tuple->value->int32;
     if (new_enable_mesh != s_enable_mesh) {
       s_enable_mesh = new_enable_mesh;
-      save_enable_mesh_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Enable mesh changed to: %d", s_enable_mesh);
-      layer_mark_dirty(s_frame_layer);
+      compositor_mark_all_dirty();
     }
   }
 
@@ -273,9 +332,9 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_val = (int)light_bg_tuple->value->int32;
     if (new_val != s_light_show_background) {
       s_light_show_background = new_val;
-      save_light_show_background_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Light show background changed to: %d", s_light_show_background);
-      layer_mark_dirty(s_frame_layer);
+      compositor_mark_all_dirty();
     }
   }
 
@@ -285,9 +344,9 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_val = (int)dark_border_tuple->value->int32;
     if (new_val != s_dark_show_border) {
       s_dark_show_border = new_val;
-      save_dark_show_border_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Dark show border changed to: %d", s_dark_show_border);
-      layer_mark_dirty(s_frame_layer);
+      compositor_mark_all_dirty();
     }
   }
 
@@ -297,20 +356,32 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     int new_val = (int)vibrate_tuple->value->int32;
     if (new_val != s_vibrate_on_disconnect) {
       s_vibrate_on_disconnect = new_val;
-      save_vibrate_on_disconnect_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Vibrate on disconnect changed to: %d", s_vibrate_on_disconnect);
     }
   }
 
+  // Read show seconds
+  Tuple *show_seconds_tuple = dict_find(iterator, MESSAGE_KEY_SHOW_SECONDS);
+  if (show_seconds_tuple) {
+    int new_val = (int)show_seconds_tuple->value->int32;
+    if (new_val != s_show_seconds) {
+      s_show_seconds = new_val;
+      settings_updated = true;
+      APP_LOG(APP_LOG_LEVEL_DEBUG, "Show seconds changed to: %d", s_show_seconds);
+      update_seconds_mode();
+    }
+  }
+
   // Read disconnect position
   Tuple *disconnect_pos_tuple = dict_find(iterator, MESSAGE_KEY_DISCONNECT_POSITION);
   if (disconnect_pos_tuple) {
     int new_disconnect_position = (int)disconnect_pos_tuple->value->int32;
     if (new_disconnect_position != s_disconnect_position) {
       s_disconnect_position = new_disconnect_position;
-      save_disconnect_position_to_storage();
+      settings_updated = true;
       APP_LOG(APP_LOG_LEVEL_DEBUG, "Disconnect position changed to: %d", s_disconnect_position);
-      update_all_info_layers();
+      store_layout();
     }
   }
 
@@ -324,39 +395,67 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     if (layout_ur) s_layer_assignments[LAYER_UPPER_RIGHT] = (InfoType)layout_ur->value->int32;
     if (layout_ll) s_layer_assignments[LAYER_LOWER_LEFT] = (InfoType)layout_ll->value->int32;
     if (layout_lr) s_layer_assignments[LAYER_LOWER_RIGHT] = (InfoType)layout_lr->value->int32;
-    save_layout_to_storage();
+    settings_updated = true;
     APP_LOG(APP_LOG_LEVEL_DEBUG, "Layout updated: %d %d %d %d",
             s_layer_assignments[0], s_layer_assignments[1],
             s_layer_assignments[2], s_layer_assignments[3]);
-    update_all_info_layers();
+    store_layout();
+  }
+
+  // All settings are one blob, written once for the whole message
+  if (settings_updated) {
+    save_settings_to_storage();
   }
+
+  // Only the dependents of the fields that really changed are refreshed,
+  // once the batched work has reported its fields too
+  deferred_request(DEFERRED_COMMIT);
+  deferred_end();
 }
 
 // --- Update Time Function ---
 
 static void update_time() {
+  format_time();
+  store_commit(STORE_SOURCE_TICK);
+}
+
+// Reformat time and date and report the fields that follow the clock. The
+// caller commits them.
+static void format_time() {
   APP_LOG(APP_LOG_LEVEL_DEBUG, "Update time");
   time_t temp = time(NULL);
   struct tm *tick_time = localtime(&temp);
 
   // Use strftime to get the time in the user's 12h or 24h format
+  char previous_time[sizeof(s_time_buffer)];
+  strcpy(previous_time, s_time_buffer);
   if (clock_is_24h_style()) {
     strftime(s_time_buffer, sizeof(s_time_buffer), "%H:%M", tick_time);
   } else {
     strftime(s_time_buffer, sizeof(s_time_buffer), "%I:%M", tick_time);
   }
 
-  layer_mark_dirty(s_time_layer);
+  // Only the digits that changed are redrawn
+  compositor_mark_dirty(s_time_layer, glyph_atlas_changed_rect(
+      fonts_get_system_font(TIME_FONT), previous_time, s_time_buffer, s_time_bounds));
 
+  char previous_date[sizeof(s_date_buffer)];
+  strcpy(previous_date, s_date_buffer);
   if (strftime(s_date_buffer, sizeof(s_date_buffer), s_date_format, tick_time) == 0) {
     // Directly show the text of the date format -- e.g. its just a text
     snprintf(s_date_buffer, sizeof(s_date_buffer), "%s", s_date_format);
   }
-  layer_mark_dirty(s_date_layer);
+  if (strcmp(previous_date, s_date_buffer) != 0) {
+    compositor_mark_dirty(s_date_layer, s_date_bounds);
+  }
 
   update_step_count();
   update_heart_rate();
   update_day();
+  store_set_int(STORE_STEPS, step_count);
+  store_set_int(STORE_HEART_RATE, heart_rate_bpm);
+  store_set_string(STORE_DATE, s_day_buffer);
 }
 
 // --- Battery Handler ---
@@ -366,58 +465,60 @@ static void battery_handler(BatteryChargeState state) {
   snprintf(s_battery_buffer, sizeof(s_battery_buffer), "%d%%", battery_level);
   
   // Update info layers to reflect new battery level
-  update_all_info_layers();
+  store_set_int(STORE_BATTERY, battery_level);
+  store_commit(STORE_SOURCE_BATTERY);
 }
 
 /**
- * @brief Stops the animation timer and resets the running flag.
+ * @brief Stops the intro animation and shows its last frame.
  */
-static void try_stop_animation_timer() {
-  if (s_animation_timer) {
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Stop animation timer");
-    app_timer_cancel(s_animation_timer);
-    s_animation_timer = NULL;
+static void try_stop_animation() {
+  if (timeline_is_running()) {
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Stop animation");
   }
-
-  current_animation_frame = 0;
+  timeline_finish();
 }
 
 /**
- * @brief Starts the animation timer if it's not already running.
+ * @brief Starts the intro animation if it's not already running.
  */
-static void try_start_animation_timer() {
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Start animation timer");
-
-  if(current_animation_frame == 0){
-    current_animation_frame = s_enable_animations == 0 ? 0 : NUM_ANIMATION_FRAMES;
-  }
+static void try_start_animation() {
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Start animation");
 
-  if(current_animation_frame > 0){
-    s_animation_timer = app_timer_register(VERY_FIRST_ANIMATION_FRAME, animation_timer_callback, NULL);
-  } else {
-    layer_mark_dirty(s_animation_layer);
+  if (s_enable_animations == 0) {
+    timeline_finish();
+    compositor_mark_layer_dirty(s_animation_layer);
+    return;
   }
+  timeline_play(VERY_FIRST_ANIMATION_FRAME);
 }
 
-/**
- * @brief AppTimer callback that triggers the frame redraw and reschedules itself.
- */
-static void animation_timer_callback(void *data) {
-  layer_mark_dirty(s_animation_layer);
-  layer_mark_dirty(s_time_layer);
-  layer_mark_dirty(s_date_layer);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Current animation frame: %d", current_animation_frame);
 
-  // Reschedule the timer for the next frame, creating a continuous loop
-  if(current_animation_frame > 0){
-    s_animation_timer = app_timer_register(ANIMATION_RATE_MS, animation_timer_callback, NULL);
-  }
+// Everything the frame layer content depends on. The cached frame is only
+// re-rendered if one of these changes.
+static uint32_t frame_cache_key() {
+  return (is_dark_theme() ? 1 : 0) |
+         (s_enable_mesh ? 2 : 0) |
+         (s_light_show_background ? 4 : 0) |
+         (s_dark_show_border ? 8 : 0);
 }
 
-
 // --- Frame Layer Drawing Update Procedure (Modified for Line Fly-In) ---
 static void draw_frame(Layer *layer, GContext *ctx) {
   GRect bounds = layer_get_bounds(layer);
+  const uint32_t cache_key = frame_cache_key();
+
+  // The frame is the bottom layer, so the forecast panels can be rendered
+  // here before anything else is drawn
+  weather_forecast_prerender(ctx, layer);
+
+  // Blit the pre-rendered frame if nothing changed since it was drawn,
+  // leaving out the rows covered by the shown forecast panels
+  if (bitmap_cache_draw_part(&s_frame_cache, ctx, bounds,
+                             weather_forecast_uncovered_rect(), cache_key)) {
+    return;
+  }
+
   GColor frame_color = get_text_color(); // Use theme-appropriate color
 
   // In case we have dark theme, we draw a border frame
@@ -429,364 +530,368 @@ static void draw_frame(Layer *layer, GContext *ctx) {
 
   // In case we have light theme, we draw a gray rectangle in the middle
   if(is_light_theme() && s_light_show_background) {
-    graphics_context_set_fill_color(ctx, GColorLightGray);
-    
     // We draw the rectange exactly from the upper to the lower animated line in  the same length
-    const int max_line_length = bounds.size.w * 0.8;
+    const int max_line_length = fixed_mul_int(LINE_LENGTH_FACTOR, bounds.size.w);
     const int line_x_start_full = (bounds.size.w - max_line_length) / 2;
     const int time_y = bounds.size.h / 2;
-#if defined(PBL_PLATFORM_EMERY)
-    const int line_y_offset = 38;
-#else
-    const int line_y_offset = 30;
-#endif
-    const int height = (line_y_offset + 2) * 2;
+    const int height = (LAYOUT_LINE_Y_OFFSET + 2) * 2;
 
-    graphics_fill_rect(ctx, GRect(line_x_start_full, time_y - line_y_offset + 4, max_line_length, height-11), 0, GCornerNone);
+    raster_fill_rect(ctx, layer, GRect(line_x_start_full, time_y - LAYOUT_LINE_Y_OFFSET + 4, max_line_length, height-11), GColorLightGray);
   }
 
-  // Dots (mesh pattern)
+  // Dots (mesh pattern), written straight into the framebuffer
   if (s_enable_mesh) {
-    graphics_context_set_stroke_color(ctx, frame_color);
-    graphics_context_set_stroke_width(ctx, 1);
-    for (int y = 0; y < bounds.size.h; y += GRID_SIZE) {
-      for (int x = 0; x < bounds.size.w; x += GRID_SIZE) {
-        // 1. Draw the horizontal part of the cross
-        // Starts at x - CROSS_SIZE and ends at x + CROSS_SIZE, centered on y
-        graphics_draw_line(
-            ctx,
-            GPoint(x - CROSS_SIZE, y),
-            GPoint(x + CROSS_SIZE, y));
-
-        // 2. Draw the vertical part of the cross
-        // Starts at y - CROSS_SIZE and ends at y + CROSS_SIZE, centered on x
-        graphics_draw_line(
-            ctx,
-            GPoint(x, y - CROSS_SIZE),
-            GPoint(x, y + CROSS_SIZE));
-      }
-    }
+    raster_fill_mesh(ctx, layer, bounds, frame_color);
   }
+
+  // Keep the rendered frame (including the window background) for the next redraws
+  bitmap_cache_store(&s_frame_cache, ctx, layer_convert_rect_to_screen(layer, bounds), cache_key);
 }
 
-static void draw_animation(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
-  GColor color = get_text_color();
+// Geometry of the two typed lines above and below time and date
+typedef struct {
+  int x_start;
+  int length;
+  int upper_y;
+  int lower_y;
+  int total_segments;
+} LineGeometry;
+
+// Typing state of a line at some frame
+typedef struct {
+  int segments;   // Complete segments
+  bool cursor;    // Blinking cursor after the last segment
+  bool done;      // Drawn as one solid line
+} TypedLine;
+
+// Seconds tick: a bar across the upper line, moving once around per minute
+#define SECONDS_TICK_WIDTH 2
+#define SECONDS_TICK_HEIGHT 7
+
+static GRect seconds_tick_bar(const LineGeometry *g, int sec) {
+  const int x = g->x_start + g->length * sec / 60;
+  return GRect(x - SECONDS_TICK_WIDTH / 2, g->upper_y - SECONDS_TICK_HEIGHT / 2,
+               SECONDS_TICK_WIDTH, SECONDS_TICK_HEIGHT);
+}
+
+// Area to redraw for the tick (one pixel around the bar)
+static GRect seconds_tick_rect(const LineGeometry *g, int sec) {
+  GRect rect = seconds_tick_bar(g, sec);
+  return GRect(rect.origin.x - 1, rect.origin.y - 1, rect.size.w + 2, rect.size.h + 2);
+}
 
-  const int max_line_length = bounds.size.w * 0.8;
-  const int line_x_start_full = (bounds.size.w - max_line_length) / 2;
-  const int line_x_end_full = line_x_start_full + max_line_length;
+static LineGeometry line_geometry(GRect bounds) {
+  LineGeometry g;
+  g.length = fixed_mul_int(LINE_LENGTH_FACTOR, bounds.size.w);
+  g.x_start = (bounds.size.w - g.length) / 2;
   const int time_y = bounds.size.h / 2;
-#if defined(PBL_PLATFORM_EMERY)
-  const int line_y_offset = 38;
-#else
-  const int line_y_offset = 30;
-#endif
-  const int segment_length = 12; // Length of each typed segment
-  const int segment_gap = 2; // Gap between segments
+  g.upper_y = time_y - LAYOUT_LINE_Y_OFFSET;
+  g.lower_y = time_y + LAYOUT_LINE_Y_OFFSET;
+  g.total_segments = (g.length + LINE_SEGMENT_LENGTH + LINE_SEGMENT_GAP - 1) / (LINE_SEGMENT_LENGTH + LINE_SEGMENT_GAP);
+  return g;
+}
 
-  current_animation_frame -= DECREASE_PER_FRAME;
-  current_animation_frame = current_animation_frame < 0 ? 0 : current_animation_frame;
+// A line is typed between the frames start and end and counts as done once
+// its progress reaches done_at
+static TypedLine typed_line(const LineGeometry *g, int elapsed, int start, int end, fixed_t done_at) {
+  TypedLine line = { 0, false, false };
+  if (elapsed < start) {
+    return line;
+  }
+  fixed_t progress = elapsed >= end ? FIXED_ONE : fixed_from_ratio(elapsed - start, end - start);
+  if (progress >= done_at) {
+    line.done = true;
+    return line;
+  }
+  line.segments = fixed_mul_int(progress, g->total_segments);
+  const int cursor_x = line.segments * (LINE_SEGMENT_LENGTH + LINE_SEGMENT_GAP);
+  const int frames_left = NUM_ANIMATION_FRAMES - elapsed;
+  line.cursor = line.segments < g->total_segments && cursor_x < g->length &&
+                (frames_left % LINE_CURSOR_BLINK_FRAMES) < LINE_CURSOR_BLINK_FRAMES / 2;
+  return line;
+}
+
+static TypedLine upper_line(const LineGeometry *g, int elapsed) {
+  return typed_line(g, elapsed, PHASE_DATE_END, PHASE_UPPER_LINE_END, FIXED_ONE);
+}
+
+static TypedLine lower_line(const LineGeometry *g, int elapsed) {
+  return typed_line(g, elapsed, PHASE_UPPER_LINE_END, NUM_ANIMATION_FRAMES, FIXED_FRAC(99, 100));
+}
+
+static void draw_typed_line(GContext *ctx, const LineGeometry *g, int y, TypedLine line) {
+  if (line.done) {
+    graphics_draw_line(ctx, GPoint(g->x_start, y), GPoint(g->x_start + g->length, y));
+    return;
+  }
+
+  // Draw complete segments only
+  for (int i = 0; i < line.segments; i++) {
+    int segment_start = i * (LINE_SEGMENT_LENGTH + LINE_SEGMENT_GAP);
+    int segment_end = segment_start + LINE_SEGMENT_LENGTH;
+
+    // Don't exceed line length
+    if (segment_start >= g->length) break;
+    if (segment_end > g->length) segment_end = g->length;
+
+    graphics_draw_line(ctx, GPoint(g->x_start + segment_start, y), GPoint(g->x_start + segment_end, y));
+  }
+
+  // Draw blinking cursor at end of last segment
+  if (line.cursor) {
+    const int cursor_x = g->x_start + line.segments * (LINE_SEGMENT_LENGTH + LINE_SEGMENT_GAP);
+    graphics_context_set_stroke_width(ctx, 2);
+    graphics_draw_line(ctx, GPoint(cursor_x, y - 3), GPoint(cursor_x, y + 3));
+    graphics_context_set_stroke_width(ctx, BORDER_THICKNESS);
+  }
+}
+
+static void draw_animation(Layer *layer, GContext *ctx) {
+  const int elapsed = timeline_elapsed();
 
-  float animation_factor = 1.0f - ((float)current_animation_frame / NUM_ANIMATION_FRAMES);
-  
   // Don't draw lines until time and date are done (after 0.40)
-  if (animation_factor < 0.40f) {
+  if (elapsed < PHASE_DATE_END) {
     return;
   }
-  
-  graphics_context_set_stroke_color(ctx, color);
+
+  const LineGeometry g = line_geometry(layer_get_bounds(layer));
+  graphics_context_set_stroke_color(ctx, get_text_color());
   graphics_context_set_stroke_width(ctx, BORDER_THICKNESS);
-  
-  // Calculate total number of segments needed for the full line
-  int total_segments = (max_line_length + segment_length + segment_gap - 1) / (segment_length + segment_gap);
-  
+
   // Typewriter effect: draw lines in discrete segments
   // Phase 3 (0.40 - 0.70): upper line, Phase 4 (0.70 - 1.0): lower line
-  if (animation_factor < 0.70f) {
-    // Upper line typing
-    float upper_progress = (animation_factor - 0.40f) / 0.30f; // 0.0 to 1.0
-    int segments_to_draw = (int)(total_segments * upper_progress);
-    
-    // Draw complete segments only
-    for (int i = 0; i < segments_to_draw; i++) {
-      int segment_start = i * (segment_length + segment_gap);
-      int segment_end = segment_start + segment_length;
-      
-      // Don't exceed line length
-      if (segment_start >= max_line_length) break;
-      if (segment_end > max_line_length) segment_end = max_line_length;
-      
-      graphics_draw_line(ctx,
-          GPoint(line_x_start_full + segment_start, time_y - line_y_offset),
-          GPoint(line_x_start_full + segment_end, time_y - line_y_offset));
-    }
-    
-    // Draw blinking cursor at end of last segment
-    if (segments_to_draw < total_segments) {
-      int cursor_x = segments_to_draw * (segment_length + segment_gap);
-      if (cursor_x < max_line_length && (current_animation_frame % 6) < 3) {
-        graphics_context_set_stroke_width(ctx, 2);
-        graphics_draw_line(ctx,
-            GPoint(line_x_start_full + cursor_x, time_y - line_y_offset - 3),
-            GPoint(line_x_start_full + cursor_x, time_y - line_y_offset + 3));
-        graphics_context_set_stroke_width(ctx, BORDER_THICKNESS);
-      }
-    }
+  const TypedLine upper = upper_line(&g, elapsed);
+  draw_typed_line(ctx, &g, g.upper_y, upper);
+  draw_typed_line(ctx, &g, g.lower_y, lower_line(&g, elapsed));
+
+  // Seconds tick, once the upper line is complete
+  if (s_seconds >= 0 && upper.done) {
+    graphics_context_set_fill_color(ctx, get_text_color());
+    graphics_fill_rect(ctx, seconds_tick_bar(&g, s_seconds), 0, GCornerNone);
+  }
+}
+
+// --- Seconds Tick ---
+// Moves the tick to sec (-1 removes it). Only the old and the new tick are
+// redrawn, everything else comes from the retained scene.
+static void show_seconds(int sec) {
+  if (sec == s_seconds) {
+    return;
+  }
+  const LineGeometry g = line_geometry(layer_get_bounds(s_animation_layer));
+  if (s_seconds >= 0) {
+    compositor_mark_dirty(s_animation_layer, seconds_tick_rect(&g, s_seconds));
+  }
+  s_seconds = sec;
+  if (s_seconds >= 0) {
+    compositor_mark_dirty(s_animation_layer, seconds_tick_rect(&g, s_seconds));
+  }
+}
+
+// Subscribe to seconds while the tick can be seen, to minutes otherwise
+static void update_seconds_mode() {
+  const bool active = s_show_seconds && s_app_focused && !s_forecast_up;
+  const TimeUnits units = active ? SECOND_UNIT : MINUTE_UNIT;
+  if (units != s_tick_units) {
+    s_tick_units = units;
+    tick_timer_service_subscribe(units, tick_handler);
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Seconds tick %s", active ? "on" : "off");
+  }
+
+  if (active) {
+    time_t now = time(NULL);
+    show_seconds(localtime(&now)->tm_sec);
   } else {
-    // Upper line complete - draw it fully
-    graphics_draw_line(ctx,
-        GPoint(line_x_start_full, time_y - line_y_offset),
-        GPoint(line_x_end_full, time_y - line_y_offset));
-    
-    // Lower line typing
-    float lower_progress = (animation_factor - 0.70f) / 0.30f; // 0.0 to 1.0
-    
-    if (lower_progress >= 0.99f) {
-      // Lower line complete - draw it fully as a solid line
-      graphics_draw_line(ctx,
-          GPoint(line_x_start_full, time_y + line_y_offset),
-          GPoint(line_x_end_full, time_y + line_y_offset));
-    } else {
-      // Lower line still typing - draw in segments
-      int segments_to_draw = (int)(total_segments * lower_progress);
-      
-      // Draw complete segments only
-      for (int i = 0; i < segments_to_draw; i++) {
-        int segment_start = i * (segment_length + segment_gap);
-        int segment_end = segment_start + segment_length;
-        
-        // Don't exceed line length
-        if (segment_start >= max_line_length) break;
-        if (segment_end > max_line_length) segment_end = max_line_length;
-        
-        graphics_draw_line(ctx,
-            GPoint(line_x_start_full + segment_start, time_y + line_y_offset),
-            GPoint(line_x_start_full + segment_end, time_y + line_y_offset));
-      }
-      
-      // Draw blinking cursor at end of last segment
-      if (segments_to_draw < total_segments) {
-        int cursor_x = segments_to_draw * (segment_length + segment_gap);
-        if (cursor_x < max_line_length && (current_animation_frame % 6) < 3) {
-          graphics_context_set_stroke_width(ctx, 2);
-          graphics_draw_line(ctx,
-              GPoint(line_x_start_full + cursor_x, time_y + line_y_offset - 3),
-              GPoint(line_x_start_full + cursor_x, time_y + line_y_offset + 3));
-          graphics_context_set_stroke_width(ctx, BORDER_THICKNESS);
-        }
-      }
-    }
+    show_seconds(-1);
+  }
+}
+
+static void app_focus_handler(bool in_focus) {
+  s_app_focused = in_focus;
+  update_seconds_mode();
+}
+
+static void forecast_overlay_handler(bool up) {
+  s_forecast_up = up;
+  update_seconds_mode();
+}
+
+// Number of characters of text typed at a frame of the phase start..end
+static int typed_chars(const char *text, int elapsed, int start, int end) {
+  const int len = strlen(text);
+  if (elapsed < start) {
+    return 0;
   }
+  if (elapsed >= end) {
+    return len;
+  }
+  return fixed_mul_int(fixed_from_ratio(elapsed - start, end - start), len);
+}
+
+// Visible state of each animation phase, the timeline only redraws a layer
+// when the state of one of its phases changes
+static int time_phase_state(int elapsed) {
+  return typed_chars(s_time_buffer, elapsed, 0, PHASE_TIME_END);
+}
+
+static int date_phase_state(int elapsed) {
+  return typed_chars(s_date_buffer, elapsed, PHASE_TIME_END, PHASE_DATE_END);
+}
+
+static int typed_line_state(TypedLine line) {
+  return line.done ? -1 : line.segments * 2 + (line.cursor ? 1 : 0);
+}
+
+static int upper_line_state(int elapsed) {
+  const LineGeometry g = line_geometry(layer_get_bounds(s_animation_layer));
+  return typed_line_state(upper_line(&g, elapsed));
+}
+
+static int lower_line_state(int elapsed) {
+  const LineGeometry g = line_geometry(layer_get_bounds(s_animation_layer));
+  return typed_line_state(lower_line(&g, elapsed));
+}
+
+// Declare the phases of the intro animation on the layers created by
+// main_window_load
+static void init_animation_timeline() {
+  const LineGeometry g = line_geometry(layer_get_bounds(s_animation_layer));
+  // Line plus the cursor, which reaches 3px above and below it
+  const int line_h = 2 * 3 + BORDER_THICKNESS;
+  // The time layer reaches down to the bottom, its text is one line at the top
+  const GSize time_size = graphics_text_layout_get_content_size(
+      "00:00", fonts_get_system_font(TIME_FONT), s_time_bounds,
+      GTextOverflowModeWordWrap, GTextAlignmentCenter);
+  s_animation_phases[0] = (TimelinePhase) {
+    .start = 0, .end = PHASE_TIME_END, .layer = &s_time_layer,
+    .dirty = GRect(s_time_bounds.origin.x, s_time_bounds.origin.y - GLYPH_ATLAS_PAD,
+                   s_time_bounds.size.w, time_size.h + 2 * GLYPH_ATLAS_PAD),
+    .state = time_phase_state };
+  s_animation_phases[1] = (TimelinePhase) {
+    .start = PHASE_TIME_END, .end = PHASE_DATE_END, .layer = &s_date_layer,
+    .dirty = s_date_bounds, .state = date_phase_state };
+  s_animation_phases[2] = (TimelinePhase) {
+    .start = PHASE_DATE_END, .end = PHASE_UPPER_LINE_END, .layer = &s_animation_layer,
+    .dirty = GRect(g.x_start - 1, g.upper_y - line_h / 2, g.length + 2, line_h), .state = upper_line_state };
+  s_animation_phases[3] = (TimelinePhase) {
+    .start = PHASE_UPPER_LINE_END, .end = NUM_ANIMATION_FRAMES, .layer = &s_animation_layer,
+    .dirty = GRect(g.x_start - 1, g.lower_y - line_h / 2, g.length + 2, line_h), .state = lower_line_state };
+
+  timeline_init(s_animation_phases, NUM_ANIMATION_PHASES, NUM_ANIMATION_FRAMES,
+                FRAMES_PER_STEP, ANIMATION_RATE_MS);
 }
 
 
 // --- Draw Time with Outline ---
-static void draw_time(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
-  GFont font = fonts_get_system_font(FONT_KEY_LECO_42_NUMBERS);
-  
-  // Calculate animation progress
-  float animation_factor = 1.0f - ((float)current_animation_frame / NUM_ANIMATION_FRAMES);
+static void render_time(GContext *ctx, Layer *layer, GRect bounds) {
+  GFont font = fonts_get_system_font(TIME_FONT);
   
   // Typewriter effect: only show characters progressively during first phase (0.0 - 0.25)
   char display_buffer[9];
-  if (animation_factor < 0.25f) {
-    float time_progress = animation_factor / 0.25f; // 0.0 to 1.0
-    int time_len = strlen(s_time_buffer);
-    int chars_to_show = (int)(time_len * time_progress);
-    
-    strncpy(display_buffer, s_time_buffer, chars_to_show);
-    display_buffer[chars_to_show] = '\0';
-  } else {
-    strcpy(display_buffer, s_time_buffer);
-  }
+  int chars_to_show = time_phase_state(timeline_elapsed());
+  strncpy(display_buffer, s_time_buffer, chars_to_show);
+  display_buffer[chars_to_show] = '\0';
   
-  // In light mode, draw white outline around black text
-  if (is_light_theme()) {
-    // Draw white outline by drawing the text 4 times with 1-pixel offsets
-    graphics_context_set_text_color(ctx, GColorWhite);
-    
-    // Left
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x - 1, bounds.origin.y, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    // Right
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x + 1, bounds.origin.y, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    // Up
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x, bounds.origin.y - 1, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    // Down
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x, bounds.origin.y + 1, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    
-    // Draw black text in center
-    graphics_context_set_text_color(ctx, GColorBlack);
-    graphics_draw_text(ctx, display_buffer, font,
-                      bounds,
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-  } else {
-    // Dark mode: just draw white text without outline
-    graphics_context_set_text_color(ctx, GColorWhite);
-    graphics_draw_text(ctx, display_buffer, font,
-                      bounds,
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+  // Blit the pre-outlined glyphs, draw the text only if the atlas is not available
+  if (!glyph_atlas_draw_text(ctx, layer, font, display_buffer, bounds, is_light_theme())) {
+    draw_theme_text(ctx, display_buffer, font, bounds, GTextAlignmentCenter, is_light_theme());
   }
 }
 
 // --- Draw Date with Outline ---
-static void draw_date(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
+static void render_date(GContext *ctx, Layer *layer, GRect bounds) {
 #if defined(PBL_PLATFORM_EMERY)
   GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD);
 #else
   GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
 #endif
   
-  // Calculate animation progress
-  float animation_factor = 1.0f - ((float)current_animation_frame / NUM_ANIMATION_FRAMES);
-  
-  // Typewriter effect: only show characters progressively during second phase (0.25 - 0.40)
+  // Typewriter effect: only show characters progressively during second phase (0.25 - 0.40),
+  // nothing while the time is still typing
   char display_buffer[20];
-  if (animation_factor < 0.25f) {
-    // Time still typing - don't show date yet
-    display_buffer[0] = '\0';
-  } else if (animation_factor < 0.40f) {
-    float date_progress = (animation_factor - 0.25f) / 0.15f; // 0.0 to 1.0
-    int date_len = strlen(s_date_buffer);
-    int chars_to_show = (int)(date_len * date_progress);
-    
-    strncpy(display_buffer, s_date_buffer, chars_to_show);
-    display_buffer[chars_to_show] = '\0';
-  } else {
-    strcpy(display_buffer, s_date_buffer);
-  }
+  int chars_to_show = date_phase_state(timeline_elapsed());
+  strncpy(display_buffer, s_date_buffer, chars_to_show);
+  display_buffer[chars_to_show] = '\0';
   
   // In light mode, draw white outline around black text
-  if (is_light_theme()) {
-    // Draw white outline by drawing the text 4 times with 1-pixel offsets
-    graphics_context_set_text_color(ctx, GColorWhite);
-    
-    // Left
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x - 1, bounds.origin.y, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    // Right
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x + 1, bounds.origin.y, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    // Up
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x, bounds.origin.y - 1, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    // Down
-    graphics_draw_text(ctx, display_buffer, font,
-                      GRect(bounds.origin.x, bounds.origin.y + 1, bounds.size.w, bounds.size.h),
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
-    
-    // Draw black text in center
-    graphics_context_set_text_color(ctx, GColorBlack);
-    graphics_draw_text(ctx, display_buffer, font,
-                      bounds,
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+  if (!gcolor_equal(s_theme.outline, GColorClear)) {
+    outline_text_draw(ctx, layer, display_buffer, font, bounds, GTextOverflowModeWordWrap,
+                      GTextAlignmentCenter, s_theme.foreground, s_theme.outline);
   } else {
-    // Dark mode: just draw white text without outline
-    graphics_context_set_text_color(ctx, GColorWhite);
-    graphics_draw_text(ctx, display_buffer, font,
-                      bounds,
-                      GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+    draw_theme_text(ctx, display_buffer, font, bounds, GTextAlignmentCenter, false);
+  }
+}
+
+#if defined(FLAT_RENDER)
+static bool info_layer_hidden(InfoLayer* info_layer);
+
+// The whole face in one pass, bottom to top
+static void draw_face(Layer *layer, GContext *ctx) {
+  draw_frame(layer, ctx);
+  draw_animation(layer, ctx);
+  render_time(ctx, layer, s_time_bounds);
+  render_date(ctx, layer, s_date_bounds);
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    if (!info_layer_hidden(&s_info_layers[i])) {
+      draw_list_render(&s_info_layers[i].draw_list, ctx, layer, s_info_layers[i].bounds.origin);
+    }
+  }
+}
+#else
+static void draw_time(Layer *layer, GContext *ctx) {
+  render_time(ctx, layer, layer_get_bounds(layer));
+}
+
+static void draw_date(Layer *layer, GContext *ctx) {
+  render_date(ctx, layer, layer_get_bounds(layer));
+}
+
+static void draw_info_layer(Layer *layer, GContext *ctx) {
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    if (s_info_layers[i].layer == layer) {
+      draw_list_render(&s_info_layers[i].draw_list, ctx, layer, GPointZero);
+    }
   }
 }
+#endif
 
 
 // --- Tick Handler ---
 static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
-  // Detect dynamic theme changes (e.g., quiet time toggling)
-  bool current_dark = is_dark_theme();
-  if (current_dark != s_last_was_dark) {
-    s_last_was_dark = current_dark;
-    update_colors();
+  compositor_bench_tick(units_changed & MINUTE_UNIT);
+  if (s_tick_units == SECOND_UNIT) {
+    show_seconds(tick_time->tm_sec);
+  }
+  if (!(units_changed & MINUTE_UNIT)) {
+    return;
   }
 
-  try_start_animation_timer();
+  // Moves the "now" marker of the forecast graph once per hour
+  weather_forecast_set_hour(tick_time->tm_hour);
+
+  // Detect dynamic theme changes (e.g., quiet time toggling), the theme is
+  // resolved once here for the whole minute
+  update_colors();
+
   update_time();
+  try_start_animation();
 }
 
 
-// Its simply a box with a border width 3 in the text color
-static void draw_colored_box_info(InfoLayer* info_layer) {
-  Layer* layer = info_layer->layer;
-  // Create a filled rectangle layer
-  info_layer->bitmap_layer_1 = bitmap_layer_create(GRect(1, 1, info_layer->bounds.size.w-2, info_layer->bounds.size.h-2));
-  bitmap_layer_set_background_color(info_layer->bitmap_layer_1, get_text_color());
-  // Add to the info layer
-  layer_add_child(layer, bitmap_layer_get_layer(info_layer->bitmap_layer_1));
+#if defined(FLAT_RENDER)
+// Slots completely below the shown forecast panels are not drawn
+static bool info_layer_hidden(InfoLayer* info_layer) {
+  return weather_forecast_covers(info_layer->bounds);
 }
 
-// Generic function to draw info based on type
-static void draw_info_for_type(InfoType info_type, InfoLayer* info_layer) {
-  switch (info_type) {
-    case INFO_TYPE_WEATHER:
-      draw_weather_info(info_layer);
-      break;
-    case INFO_TYPE_TEMPERATURE:
-      draw_temperature_info(info_layer);
-      break;
-    case INFO_TYPE_STEPS:
-      draw_steps_info(info_layer);
-      break;
-    case INFO_TYPE_BATTERY:
-      draw_battery_info(info_layer);
-      break;
-    case INFO_TYPE_CALENDAR:
-      draw_calendar_info(info_layer);
-      break;
-    case INFO_TYPE_DISCONNECT:
-      draw_disconnect_info(info_layer);
-      break;
-    case INFO_TYPE_HEART_RATE:
-      draw_heart_rate_info(info_layer);
-      break;
-    case INFO_TYPE_COLORED_BOX:
-      draw_colored_box_info(info_layer);
-      break;
-    case INFO_TYPE_NONE:
-      // Do nothing for empty layers
-      break;
-  }
+static void mark_info_layer_dirty(InfoLayer* info_layer) {
+  compositor_mark_dirty(s_face_layer, info_layer->bounds);
 }
-
-// Clear all child layers from an info layer
-static void clear_info_layer(InfoLayer* info_layer) {
-  if (info_layer->text_layer1) {
-    text_layer_destroy(info_layer->text_layer1);
-    info_layer->text_layer1 = NULL;
-  }
-  if (info_layer->text_layer2) {
-    text_layer_destroy(info_layer->text_layer2);
-    info_layer->text_layer2 = NULL;
-  }
-  if (info_layer->bitmap_layer_1) {
-    bitmap_layer_destroy(info_layer->bitmap_layer_1);
-    info_layer->bitmap_layer_1 = NULL;
-  }
-  if (info_layer->bitmap_layer_2) {
-    bitmap_layer_destroy(info_layer->bitmap_layer_2);
-    info_layer->bitmap_layer_2 = NULL;
-  }
-  if (info_layer->bitmap_layer_3) {
-    bitmap_layer_destroy(info_layer->bitmap_layer_3);
-    info_layer->bitmap_layer_3 = NULL;
-  }
-  if (info_layer->custom_layer) {
-    layer_destroy(info_layer->custom_layer);
-    info_layer->custom_layer = NULL;
-  }
+#else
+static void mark_info_layer_dirty(InfoLayer* info_layer) {
+  compositor_mark_layer_dirty(info_layer->layer);
 }
+#endif
 
 static void vibrate_done_callback(void *data) {
   s_is_vibrating = false;
@@ -810,8 +915,35 @@ static void vibrate_connection_changed() {
   app_timer_register(900, vibrate_done_callback, NULL);
 }
 
+// Info type shown at slot i
+static InfoType info_type_of_slot(int i, bool connected) {
+  // Override with disconnect icon if disconnected and this is the configured position
+  // s_disconnect_position: 1=UL, 2=UR, 3=LL, 4=LR (maps to i+1)
+  if (!connected && s_disconnect_position > 0 && s_disconnect_position == i + 1) {
+    return INFO_TYPE_DISCONNECT;
+  }
+  return s_layer_assignments[i];
+}
+
+// Refresh only the slots whose widget reads one of the changed store
+// fields. A slot is only redrawn if its content differs from what is on
+// screen. Returns the number of refreshed slots.
+static int update_info_layers(uint32_t changed) {
+  int refreshed = 0;
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    const Widget* widget = s_info_layers[i].widget;
+    if (widget && (widget->reads & changed)) {
+      refreshed++;
+      if (widget_update_slot(&s_info_layers[i])) {
+        mark_info_layer_dirty(&s_info_layers[i]);
+      }
+    }
+  }
+  return refreshed;
+}
+
 // Update all info layers according to current assignments
-static void update_all_info_layers() {
+static int update_all_info_layers() {
   bool connected = connection_service_peek_pebble_app_connection();
   
   // Detect connection state change and vibrate
@@ -820,24 +952,68 @@ static void update_all_info_layers() {
   }
   s_last_connected = (int)connected;
 
+  // Widgets are only rebound if a slot shows another info type now
+  InfoType types[NUM_INFO_LAYERS];
   for (int i = 0; i < NUM_INFO_LAYERS; i++) {
-    // Clear existing content first
-    clear_info_layer(&s_info_layers[i]);
-
-    // Override with disconnect icon if disconnected and this is the configured position
-    // s_disconnect_position: 1=UL, 2=UR, 3=LL, 4=LR (maps to i+1)
-    if (!connected && s_disconnect_position > 0 && s_disconnect_position == i + 1) {
-      draw_info_for_type(INFO_TYPE_DISCONNECT, &s_info_layers[i]);
-    } else {
-      draw_info_for_type(s_layer_assignments[i], &s_info_layers[i]);
+    types[i] = info_type_of_slot(i, connected);
+  }
+  const bool rebound = widget_bind_slots(s_info_layers, types, NUM_INFO_LAYERS);
+
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    if (widget_update_slot(&s_info_layers[i]) || rebound) {
+      mark_info_layer_dirty(&s_info_layers[i]);
     }
   }
+  return NUM_INFO_LAYERS;
+}
+
+// Layout assignments and the disconnect position decide the slot types
+static void store_layout() {
+  struct {
+    InfoType assignments[NUM_INFO_LAYERS];
+    int disconnect_position;
+  } layout;
+  memset(&layout, 0, sizeof(layout));
+  memcpy(layout.assignments, s_layer_assignments, sizeof(layout.assignments));
+  layout.disconnect_position = s_disconnect_position;
+  store_set(STORE_LAYOUT, &layout, sizeof(layout));
+}
+
+// Store listener: invalidate what depends on the changed fields
+static int store_changed(uint32_t changed) {
+  // Day and night use different weather icons
+  if (changed & (STORE_BIT(STORE_CONDITION) | STORE_BIT(STORE_IS_DAY))) {
+    load_weather_icon();
+  }
+  if (changed & STORE_BIT(STORE_IS_DAY)) {
+    deferred_request(DEFERRED_FORECAST_ICONS);
+  }
+
+  // The slot types depend on the layout and the connection. A rebuild
+  // already pending in the batch refreshes every slot anyway.
+  if (changed & (STORE_BIT(STORE_LAYOUT) | STORE_BIT(STORE_CONNECTION)) ||
+      deferred_pending(DEFERRED_REBUILD_SLOTS)) {
+    deferred_request(DEFERRED_REBUILD_SLOTS);
+    return NUM_INFO_LAYERS;
+  }
+  return update_info_layers(changed);
+}
+
+// Only app messages batch their work
+static void commit_message() {
+  store_commit(STORE_SOURCE_MESSAGE);
+}
+
+static void rebuild_info_layers() {
+  update_all_info_layers();
+  memstats_record(MEMSTATS_REBUILD);
 }
 
 // Bluetooth connection handler
 static void bluetooth_connection_handler(bool connected) {
   APP_LOG(APP_LOG_LEVEL_DEBUG, "Bluetooth connection: %s", connected ? "connected" : "disconnected");
-  update_all_info_layers();
+  store_set_int(STORE_CONNECTION, connected);
+  store_commit(STORE_SOURCE_CONNECTION);
 }
 
 // Tap/flick handler - configurable: off, single flick, or double flick
@@ -884,58 +1060,25 @@ static void delayed_weather_request(void *data) {
 }
 
 // Initialize the 4 info layers with proper positioning
-static void init_info_layers(GRect bounds) {
+static void init_info_layers() {
+  // The slots shrink to make room for the border of the dark theme
+  LayoutVariant variant = (is_dark_theme() && s_dark_show_border) ? LAYOUT_VARIANT_BORDER : LAYOUT_VARIANT_PLAIN;
 
-  int theme_offset = (is_dark_theme() && s_dark_show_border) ? 2 : 0;
-  const int info_layer_width = bounds.size.w / 2 - BORDER_THICKNESS - 2 - theme_offset;
-#if defined(PBL_PLATFORM_EMERY)
-  const int info_layer_height = 60;
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    // Bound to their widgets by update_all_info_layers
+    s_info_layers[i].widget = NULL;
+    s_info_layers[i].bounds = layout_slots[variant][i];
+    s_info_layers[i].position = i;
+    s_info_layers[i].layout = layout_elements[variant];
+    draw_list_init(&s_info_layers[i].draw_list, NULL, 0);
+#if defined(FLAT_RENDER)
+    // Drawn by the face layer
+    s_info_layers[i].layer = NULL;
 #else
-  const int info_layer_height = 44;
+    s_info_layers[i].layer = layer_create(s_info_layers[i].bounds);
+    layer_set_update_proc(s_info_layers[i].layer, draw_info_layer);
 #endif
-
-  int margin_w = 6 + theme_offset;
-  const int margin_h = 4;
-
-  // Upper left
-  s_info_layers[LAYER_UPPER_LEFT].bounds = GRect(margin_w, margin_h, info_layer_width, info_layer_height);
-  s_info_layers[LAYER_UPPER_LEFT].position = LAYER_UPPER_LEFT;
-  s_info_layers[LAYER_UPPER_LEFT].layer = layer_create(s_info_layers[LAYER_UPPER_LEFT].bounds);
-  s_info_layers[LAYER_UPPER_LEFT].text_layer1 = NULL;
-  s_info_layers[LAYER_UPPER_LEFT].text_layer2 = NULL;
-  s_info_layers[LAYER_UPPER_LEFT].bitmap_layer_1 = NULL;
-  s_info_layers[LAYER_UPPER_LEFT].bitmap_layer_2 = NULL;
-  s_info_layers[LAYER_UPPER_LEFT].bitmap_layer_3 = NULL;
-  
-  // Upper right 
-  s_info_layers[LAYER_UPPER_RIGHT].bounds = GRect(bounds.size.w - info_layer_width - margin_w, margin_h, info_layer_width, info_layer_height);
-  s_info_layers[LAYER_UPPER_RIGHT].position = LAYER_UPPER_RIGHT;
-  s_info_layers[LAYER_UPPER_RIGHT].layer = layer_create(s_info_layers[LAYER_UPPER_RIGHT].bounds);
-  s_info_layers[LAYER_UPPER_RIGHT].text_layer1 = NULL;
-  s_info_layers[LAYER_UPPER_RIGHT].text_layer2 = NULL;
-  s_info_layers[LAYER_UPPER_RIGHT].bitmap_layer_1 = NULL;
-  s_info_layers[LAYER_UPPER_RIGHT].bitmap_layer_2 = NULL;
-  s_info_layers[LAYER_UPPER_RIGHT].bitmap_layer_3 = NULL;
-  
-  // Lower left
-  s_info_layers[LAYER_LOWER_LEFT].bounds = GRect(margin_w, bounds.size.h - info_layer_height - margin_h, info_layer_width, info_layer_height);
-  s_info_layers[LAYER_LOWER_LEFT].position = LAYER_LOWER_LEFT;
-  s_info_layers[LAYER_LOWER_LEFT].layer = layer_create(s_info_layers[LAYER_LOWER_LEFT].bounds);
-  s_info_layers[LAYER_LOWER_LEFT].text_layer1 = NULL;
-  s_info_layers[LAYER_LOWER_LEFT].text_layer2 = NULL;
-  s_info_layers[LAYER_LOWER_LEFT].bitmap_layer_1 = NULL;
-  s_info_layers[LAYER_LOWER_LEFT].bitmap_layer_2 = NULL;
-  s_info_layers[LAYER_LOWER_LEFT].bitmap_layer_3 = NULL;
-  
-  // Lower right
-  s_info_layers[LAYER_LOWER_RIGHT].bounds = GRect(bounds.size.w - info_layer_width - margin_w, bounds.size.h - info_layer_height - margin_h, info_layer_width, info_layer_height);
-  s_info_layers[LAYER_LOWER_RIGHT].position = LAYER_LOWER_RIGHT;
-  s_info_layers[LAYER_LOWER_RIGHT].layer = layer_create(s_info_layers[LAYER_LOWER_RIGHT].bounds);
-  s_info_layers[LAYER_LOWER_RIGHT].text_layer1 = NULL;
-  s_info_layers[LAYER_LOWER_RIGHT].text_layer2 = NULL;
-  s_info_layers[LAYER_LOWER_RIGHT].bitmap_layer_1 = NULL;
-  s_info_layers[LAYER_LOWER_RIGHT].bitmap_layer_2 = NULL;
-  s_info_layers[LAYER_LOWER_RIGHT].bitmap_layer_3 = NULL;
+  }
 }
 
 
@@ -943,10 +1086,13 @@ static void init_info_layers(GRect bounds) {
 static void main_window_appear(Window *window) {
   APP_LOG(APP_LOG_LEVEL_DEBUG, "Window appear");
 
-  // Start animation and update UI immediately
-  try_start_animation_timer();
+  // Whatever was shown before drew over the framebuffer
+  compositor_restore();
+
+  // Update UI immediately, the animation starts from the current time
+  update_time();
   battery_handler(battery_state_service_peek());
-  update_time(); // Ensure time is displayed immediately
+  try_start_animation();
 
   // Request weather update after a short delay to prevent blocking UI
   app_timer_register(100, delayed_weather_request, NULL);
@@ -958,48 +1104,74 @@ static void main_window_load(Window *window) {
   Layer *window_layer = window_get_root_layer(window);
   GRect bounds = layer_get_bounds(window_layer);
 
+  // Everything below the forecast panels lives in the scene layer, which
+  // only redraws the parts that changed
+  s_scene_layer = layer_create(bounds);
+  layer_add_child(window_layer, s_scene_layer);
+  compositor_init(s_scene_layer, bounds);
+
+  // Time (and the date below it) centered on the screen
+  const GRect time_frame = layout_time;
+  const GRect date_frame = layout_date;
+
+#if defined(FLAT_RENDER)
+  // One layer for frame, lines, time, date and the info slots
+  s_face_layer = layer_create(bounds);
+  layer_set_update_proc(s_face_layer, draw_face);
+  compositor_add_child(s_face_layer);
+  s_frame_layer = s_face_layer;
+  s_animation_layer = s_face_layer;
+  s_time_layer = s_face_layer;
+  s_date_layer = s_face_layer;
+  s_time_bounds = time_frame;
+  s_date_bounds = date_frame;
+#else
   // Create frame layer
   s_frame_layer = layer_create(bounds);
   layer_set_update_proc(s_frame_layer, draw_frame);
-  layer_add_child(window_layer, s_frame_layer);
+  compositor_add_child(s_frame_layer);
 
   // Create animation layer
   s_animation_layer = layer_create(bounds);
   layer_set_update_proc(s_animation_layer, draw_animation);
-  layer_add_child(window_layer, s_animation_layer);
+  compositor_add_child(s_animation_layer);
 
   // Create Time Layer
-#if defined(PBL_PLATFORM_EMERY)
-  const int time_y_pos = bounds.size.h / 2 - 20 - 18;
-#else
-  const int time_y_pos = bounds.size.h / 2 - 20 - 14;
-#endif
-  s_time_layer = layer_create(
-      GRect(0, time_y_pos, bounds.size.w, bounds.size.h));
+  s_time_layer = layer_create(time_frame);
   layer_set_update_proc(s_time_layer, draw_time);
-  layer_add_child(window_layer, s_time_layer);
+  compositor_add_child(s_time_layer);
+  s_time_bounds = layer_get_bounds(s_time_layer);
 
   // Create the Date Layer (Center below time)
-#if defined(PBL_PLATFORM_EMERY)
-  s_date_layer = layer_create(
-      GRect(0, time_y_pos + 44, bounds.size.w, 28));
-#else
-  s_date_layer = layer_create(
-      GRect(0, time_y_pos + 38, bounds.size.w, 24));
-#endif
+  s_date_layer = layer_create(date_frame);
   layer_set_update_proc(s_date_layer, draw_date);
-  layer_add_child(window_layer, s_date_layer);
+  compositor_add_child(s_date_layer);
+  s_date_bounds = layer_get_bounds(s_date_layer);
+#endif
+
+  // Typewriter intro animation on the time, date and animation layers
+  init_animation_timeline();
 
   // Initialize the 4 info layers
-  init_info_layers(bounds);
-  
-  // Add the info layers to the window
+  init_info_layers();
+
+#if !defined(FLAT_RENDER)
+  // Add the info layers to the scene
   for (int i = 0; i < NUM_INFO_LAYERS; i++) {
-    layer_add_child(window_layer, s_info_layers[i].layer);
+    compositor_add_child(s_info_layers[i].layer);
   }
+#endif
 
   // Initialize weather forecast bar (on top of info layers)
-  weather_forecast_init(window_layer, bounds);
+  weather_forecast_set_overlay_handler(forecast_overlay_handler);
+  weather_forecast_init(window_layer, s_scene_layer, bounds);
+
+#if !defined(FLAT_RENDER)
+  // Info slots below the shown forecast panels are not drawn at all
+  for (int i = 0; i < NUM_INFO_LAYERS; i++) {
+    weather_forecast_add_occluded_layer(s_info_layers[i].layer);
+  }
+#endif
 
   // Initialize PDC icons for use in info drawing functions
   load_weather_icon();
@@ -1015,45 +1187,41 @@ static void main_window_load(Window *window) {
 
   // Make sure the initial time is displayed
   update_time();
+  memstats_record(MEMSTATS_WINDOW_LOAD);
 }
 
 static void main_window_unload(Window *window) {
   // Destroy the main layers
+#if defined(FLAT_RENDER)
+  layer_destroy(s_face_layer);
+#else
   layer_destroy(s_time_layer);
   layer_destroy(s_date_layer);
   layer_destroy(s_frame_layer);
   layer_destroy(s_animation_layer);
+#endif
+  bitmap_cache_destroy(&s_frame_cache);
+  glyph_atlas_destroy();
+  icon_cache_destroy();
 
   // Destroy weather forecast layer
   weather_forecast_deinit();
 
-  // Destroy info layers (this will also destroy all their children via clear_info_layer)
+  // Destroy info layers
   for (int i = 0; i < NUM_INFO_LAYERS; i++) {
     if (s_info_layers[i].layer) {
-      clear_info_layer(&s_info_layers[i]);
       layer_destroy(s_info_layers[i].layer);
     }
   }
+  compositor_deinit();
+  layer_destroy(s_scene_layer);
 
-  // Destroy bitmaps
-  if (s_step_icon) {
-    gdraw_command_image_destroy(s_step_icon);
-  }
-  if (s_weather_icon) {
-    gdraw_command_image_destroy(s_weather_icon);
-  }
-  if (s_battery_icon) {
-    gdraw_command_image_destroy(s_battery_icon);
-  }
-  if (s_calendar_icon) {
-    gdraw_command_image_destroy(s_calendar_icon);
-  }
-  if (s_disconnect_icon) {
-    gdraw_command_image_destroy(s_disconnect_icon);
-  }
-  if (s_heart_icon) {
-    gdraw_command_image_destroy(s_heart_icon);
-  }
+  // Write what is still waiting in the journal
+  journal_flush();
+
+  // Release the icons and everything else of the window in one step
+  release_pdc_icons();
+  arena_reset();
 }
 
 // --- Initialization and Deinitialization ---
@@ -1061,56 +1229,35 @@ static void main_window_unload(Window *window) {
 static void init() {
   srand(time(NULL));
 
-  // Load saved theme preference before creating UI
-  load_theme_from_storage();
-  
-  // Load saved step goal preference
-  load_step_goal_from_storage();
-  
-  // Load saved temperature unit preference
-  load_temperature_unit_from_storage();
-
-  // Load animation
-  load_enable_animations_from_storage();
-  
-  // Load saved weather data from storage
+  // Load the saved settings (one blob) and the last weather
+  load_settings_from_storage();
   load_weather_from_storage();
 
-  // Load saved layout assignments
-  load_layout_from_storage();
-
-  // Load saved disconnect position
-  load_disconnect_position_from_storage();
-
-  // Load saved weather detail preferences
-  load_weather_forecast_flick_mode_from_storage();
-  load_weather_forecast_duration_from_storage();
-
-  // Load saved mesh preference
-  load_enable_mesh_from_storage();
-
-  // Load saved date format preference
-  load_date_format_from_storage();
-  load_light_show_background_from_storage();
-  load_dark_show_border_from_storage();
-  load_vibrate_on_disconnect_from_storage();
-
-  s_last_was_dark = is_dark_theme();
+  // Resolve the theme before anything is created or drawn
+  theme_refresh();
 
   s_main_window = window_create();
-  window_set_background_color(s_main_window, get_background_color());
+  // The compositor clears what it redraws, the rest of the framebuffer
+  // keeps the previous frame
+  window_set_background_color(s_main_window, GColorClear);
 
   window_set_window_handlers(s_main_window, (WindowHandlers){
                                                 .load = main_window_load,
                                                 .unload = main_window_unload,
                                                 .appear = main_window_appear});
 
+  // Data changes reach the info slots through the store
+  store_set_listener(store_changed);
+  deferred_set_handler(DEFERRED_FORECAST_ICONS, weather_forecast_update_icons);
+  deferred_set_handler(DEFERRED_RETHEME, update_colors);
+  deferred_set_handler(DEFERRED_REBUILD_SLOTS, rebuild_info_layers);
+  deferred_set_handler(DEFERRED_RETIME, format_time);
+  deferred_set_handler(DEFERRED_COMMIT, commit_message);
+
   // Initialize App Message
   app_message_register_inbox_received(inbox_received_callback);
-  app_message_open(768, 128); // Buffer size for weather + forecast + layout + config data
-
-  // Subscribe to MINUTE_UNIT (for time update/minute-start trigger) and SECOND_UNIT (for stop trigger)
-  tick_timer_service_subscribe(MINUTE_UNIT, tick_handler);
+  // Inbox: weather + forecast + layout + config data. Outbox: requests and the memstats report.
+  app_message_open(768, 256);
 
   // Subscribe to battery state updates
   battery_state_service_subscribe(battery_handler);
@@ -1125,22 +1272,37 @@ static void init() {
 
   window_stack_push(s_main_window, true);
 
+  // Subscribe to MINUTE_UNIT for the time, or to SECOND_UNIT while the
+  // seconds tick is shown
+  app_focus_service_subscribe_handlers((AppFocusHandlers) {
+    .did_focus = app_focus_handler
+  });
+  update_seconds_mode();
+
+  memstats_record(MEMSTATS_INIT);
   APP_LOG(APP_LOG_LEVEL_DEBUG, "Finished init");
 }
 
 static void deinit() {
-  try_stop_animation_timer();
+  try_stop_animation();
   window_destroy(s_main_window);
   tick_timer_service_unsubscribe();
+  app_focus_service_unsubscribe();
   battery_state_service_unsubscribe();
   connection_service_unsubscribe();
   accel_tap_service_unsubscribe();
+  journal_flush();
+  journal_log();
+  store_log();
+  memstats_log();
+  compositor_bench_log();
 }
 
 // --- Main Program Loop ---
 
 int main(void)
 {
+  memstats_paint_stack();
   init();
   app_event_loop();
   deinit();
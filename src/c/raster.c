@@ -0,0 +1,177 @@
+#include "raster.h"
+#include "compositor.h"
+
+// Framebuffer region to work on, already clipped to the layer and the screen
+typedef struct {
+  GBitmap *fb;
+  uint8_t *data;
+  int stride;
+  GRect area;   // screen coordinates, unclipped (defines the mesh phase)
+  int x0, x1;   // clipped columns [x0, x1)
+  int y0, y1;   // clipped rows [y0, y1)
+} RasterTarget;
+
+static bool raster_begin(GContext *ctx, Layer *layer, GRect rect, RasterTarget *target) {
+  target->fb = graphics_capture_frame_buffer(ctx);
+  if (!target->fb) {
+    return false;
+  }
+
+  GRect fb_bounds = gbitmap_get_bounds(target->fb);
+  GRect visible = layer_convert_rect_to_screen(layer, layer_get_bounds(layer));
+  GRect clip = compositor_clip();
+  grect_clip(&visible, &clip);
+  target->area = layer_convert_rect_to_screen(layer, rect);
+
+  target->x0 = target->area.origin.x;
+  target->y0 = target->area.origin.y;
+  target->x1 = target->area.origin.x + target->area.size.w;
+  target->y1 = target->area.origin.y + target->area.size.h;
+  if (target->x0 < visible.origin.x) target->x0 = visible.origin.x;
+  if (target->y0 < visible.origin.y) target->y0 = visible.origin.y;
+  if (target->x1 > visible.origin.x + visible.size.w) target->x1 = visible.origin.x + visible.size.w;
+  if (target->y1 > visible.origin.y + visible.size.h) target->y1 = visible.origin.y + visible.size.h;
+  if (target->x0 < 0) target->x0 = 0;
+  if (target->y0 < 0) target->y0 = 0;
+  if (target->x1 > fb_bounds.size.w) target->x1 = fb_bounds.size.w;
+  if (target->y1 > fb_bounds.size.h) target->y1 = fb_bounds.size.h;
+
+  target->data = gbitmap_get_data(target->fb);
+  target->stride = gbitmap_get_bytes_per_row(target->fb);
+  return true;
+}
+
+static void raster_end(GContext *ctx, RasterTarget *target) {
+  graphics_release_frame_buffer(ctx, target->fb);
+}
+
+// --- 1-bit kernels (aplite, diorite): 32 pixels per word, LSB is leftmost ---
+
+// Same color mapping the firmware uses for 1-bit fills: gray becomes a
+// checkerboard that flips every row.
+static uint32_t color_pattern_1bit(GColor color, int y) {
+  const int luminance = (color.r + color.g + color.b) / 3;
+  if (luminance == 0) {
+    return 0x00000000;
+  } else if (luminance == 3) {
+    return 0xFFFFFFFF;
+  }
+  return (y % 2) ? 0xAAAAAAAA : 0x55555555;
+}
+
+// Replace the pixels selected by mask within [x0, x1) with value
+static void blend_span_1bit(uint8_t *row, int x0, int x1, uint32_t mask, uint32_t value) {
+  if (((uintptr_t)row & 3) == 0) {
+    uint32_t *words = (uint32_t *)row;
+    const int w0 = x0 >> 5;
+    const int w1 = (x1 - 1) >> 5;
+    for (int w = w0; w <= w1; w++) {
+      uint32_t m = mask;
+      if (w == w0) m &= 0xFFFFFFFFu << (x0 & 31);
+      if (w == w1) m &= 0xFFFFFFFFu >> (31 - ((x1 - 1) & 31));
+      words[w] = (words[w] & ~m) | (value & m);
+    }
+  } else {
+    // Rows that are not word aligned fall back to the same operation per byte
+    const int b0 = x0 >> 3;
+    const int b1 = (x1 - 1) >> 3;
+    for (int b = b0; b <= b1; b++) {
+      uint8_t m = (uint8_t)(mask >> ((b & 3) * 8));
+      if (b == b0) m &= (uint8_t)(0xFF << (x0 & 7));
+      if (b == b1) m &= (uint8_t)(0xFF >> (7 - ((x1 - 1) & 7)));
+      row[b] = (row[b] & ~m) | ((uint8_t)(value >> ((b & 3) * 8)) & m);
+    }
+  }
+}
+
+static void fill_rect_1bit(RasterTarget *t, GColor color) {
+  for (int y = t->y0; y < t->y1; y++) {
+    blend_span_1bit(t->data + y * t->stride, t->x0, t->x1, 0xFFFFFFFF, color_pattern_1bit(color, y));
+  }
+}
+
+static void fill_mesh_1bit(RasterTarget *t, GColor color, int first_y) {
+  // Precompute the dot columns of one 32-pixel word for the phase of the grid
+  const int phase = ((t->area.origin.x % MESH_GRID_SIZE) + MESH_GRID_SIZE) % MESH_GRID_SIZE;
+  uint32_t mask = 0;
+  for (int x = phase; x < 32; x += MESH_GRID_SIZE) {
+    mask |= 1u << x;
+  }
+  for (int y = first_y; y < t->y1; y += MESH_GRID_SIZE) {
+    blend_span_1bit(t->data + y * t->stride, t->x0, t->x1, mask, color_pattern_1bit(color, y));
+  }
+}
+
+// --- 8-bit kernels (basalt, emery): one GColor8 per byte ---
+
+static void fill_rect_8bit(RasterTarget *t, GColor color) {
+  const uint32_t word = color.argb * 0x01010101u;
+  for (int y = t->y0; y < t->y1; y++) {
+    uint8_t *p = t->data + y * t->stride + t->x0;
+    uint8_t *end = t->data + y * t->stride + t->x1;
+    while (p < end && ((uintptr_t)p & 3)) {
+      *p++ = color.argb;
+    }
+    while (p + 4 <= end) {
+      *(uint32_t *)p = word;
+      p += 4;
+    }
+    while (p < end) {
+      *p++ = color.argb;
+    }
+  }
+}
+
+static void fill_mesh_8bit(RasterTarget *t, GColor color, int first_y) {
+  // Only one pixel in MESH_GRID_SIZE is written, so a single byte store per
+  // dot beats a read-modify-write of the surrounding words.
+  int first_x = t->area.origin.x;
+  if (first_x < t->x0) {
+    first_x += ((t->x0 - first_x + MESH_GRID_SIZE - 1) / MESH_GRID_SIZE) * MESH_GRID_SIZE;
+  }
+  for (int y = first_y; y < t->y1; y += MESH_GRID_SIZE) {
+    uint8_t *row = t->data + y * t->stride;
+    for (int x = first_x; x < t->x1; x += MESH_GRID_SIZE) {
+      row[x] = color.argb;
+    }
+  }
+}
+
+/*
+ * Public API
+ */
+
+void raster_fill_rect(GContext *ctx, Layer *layer, GRect rect, GColor color) {
+  RasterTarget target;
+  if (!raster_begin(ctx, layer, rect, &target)) {
+    return;
+  }
+  if (target.x0 < target.x1 && target.y0 < target.y1) {
+    if (gbitmap_get_format(target.fb) == GBitmapFormat1Bit) {
+      fill_rect_1bit(&target, color);
+    } else {
+      fill_rect_8bit(&target, color);
+    }
+  }
+  raster_end(ctx, &target);
+}
+
+void raster_fill_mesh(GContext *ctx, Layer *layer, GRect rect, GColor color) {
+  RasterTarget target;
+  if (!raster_begin(ctx, layer, rect, &target)) {
+    return;
+  }
+  if (target.x0 < target.x1 && target.y0 < target.y1) {
+    // First dot row that is on screen
+    int first_y = target.area.origin.y;
+    if (first_y < target.y0) {
+      first_y += ((target.y0 - first_y + MESH_GRID_SIZE - 1) / MESH_GRID_SIZE) * MESH_GRID_SIZE;
+    }
+    if (gbitmap_get_format(target.fb) == GBitmapFormat1Bit) {
+      fill_mesh_1bit(&target, color, first_y);
+    } else {
+      fill_mesh_8bit(&target, color, first_y);
+    }
+  }
+  raster_end(ctx, &target);
+}
@@ -0,0 +1,26 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Distance between two mesh dots. Must divide 32 so that one precomputed
+// 32-bit word covers the pattern of a 1-bit framebuffer row.
+#define MESH_GRID_SIZE 8
+
+/*
+ * Function Declarations
+ */
+
+// Fill rect (layer coordinates) directly in the framebuffer. Pixel-identical
+// to graphics_fill_rect(), including the gray dithering of 1-bit displays.
+void raster_fill_rect(GContext *ctx, Layer *layer, GRect rect, GColor color);
+
+// Draw the mesh dot pattern: one dot every MESH_GRID_SIZE pixels starting at
+// the origin of rect (layer coordinates). Pixels between the dots are kept.
+void raster_fill_mesh(GContext *ctx, Layer *layer, GRect rect, GColor color);
+
+#endif // RASTER_H
@@ -11,15 +11,8 @@ int step_count = 0;
  * Function Implementations
  */
 
-static void step_icon_layer_update_proc(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
-  GPoint origin = GPoint((bounds.size.w - gdraw_command_image_get_bounds_size(s_step_icon).w) / 2,
-                         (bounds.size.h - gdraw_command_image_get_bounds_size(s_step_icon).h) / 2);
-  gdraw_command_image_draw(ctx, s_step_icon, origin);
-}
-
 void load_step_icon() {
-  load_pdc_icon(&s_step_icon, RESOURCE_ID_IMAGE_STEP, ORIG_STEP_ICON_SIZE, STEP_ICON_SIZE);
+  load_pdc_icon(&s_step_icon, RESOURCE_ID_IMAGE_STEP);
 }
 
 void update_step_count() {
@@ -31,55 +24,33 @@ void update_step_count() {
   }
 }
 
-void draw_steps_info(InfoLayer* info_layer) {
-  GRect bounds = info_layer->bounds;
-  Layer* layer = info_layer->layer;
-  
-  GRect icon_frame;
-  GRect text_frame;
-  GRect step_count_rect;
+static void draw_steps_info(InfoLayer* info_layer) {
+  DrawList *list = &info_layer->draw_list;
 
-  int y_pos = bounds.size.h / 4 + 1;
-  int x_pos = bounds.size.w / 2 - STEP_ICON_SIZE / 2;
-  icon_frame = GRect(x_pos, y_pos-STEP_ICON_SIZE / 2 + 1, STEP_ICON_SIZE, STEP_ICON_SIZE);
-#if defined(PBL_PLATFORM_EMERY)
-  text_frame = GRect(0, y_pos+10, bounds.size.w, 32);
-#else
-  text_frame = GRect(0, y_pos+6, bounds.size.w, 28);
-#endif
-  
-  // Create step icon layer via PDC draw command
-  info_layer->custom_layer = layer_create(icon_frame);
-  layer_set_update_proc(info_layer->custom_layer, step_icon_layer_update_proc);
-  
-  info_layer->text_layer1 = text_layer_create(text_frame);
-  text_layer_set_background_color(info_layer->text_layer1, GColorClear);
-  text_layer_set_text_color(info_layer->text_layer1, get_text_color());
-  text_layer_set_text(info_layer->text_layer1, s_step_buffer);
 #if defined(PBL_PLATFORM_EMERY)
-  text_layer_set_font(info_layer->text_layer1, fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD));
+  GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD);
 #else
-  text_layer_set_font(info_layer->text_layer1, fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD));
+  GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
 #endif
-  text_layer_set_text_alignment(info_layer->text_layer1, GTextAlignmentCenter);
-  
-  int full_width = STEP_ICON_SIZE-1;
-  int full_height = STEP_ICON_SIZE / 2;
 
-  // Full background rectangle layer
-  step_count_rect = GRect(x_pos, y_pos-STEP_ICON_SIZE / 6, full_width, full_height);
-  info_layer->bitmap_layer_3 = bitmap_layer_create(step_count_rect);
-  bitmap_layer_set_background_color(info_layer->bitmap_layer_3, get_background_color());
+  // Full background rectangle
+  GRect step_count_rect = info_layer->layout[LAYOUT_STEPS_BAR];
+  draw_list_fill(list, step_count_rect, get_background_color());
 
-  // Create small rectangle layer with text color background
+  // Small rectangle for the progress towards the goal
   int steps = step_count > s_step_goal ? s_step_goal : step_count;
-  int real_width = (steps * full_width) / s_step_goal;
-  step_count_rect = GRect(x_pos, y_pos-STEP_ICON_SIZE / 6, real_width, full_height);
-  info_layer->bitmap_layer_2 = bitmap_layer_create(step_count_rect);
-  bitmap_layer_set_background_color(info_layer->bitmap_layer_2, GColorLightGray);
-  
-  layer_add_child(layer, bitmap_layer_get_layer(info_layer->bitmap_layer_3));
-  layer_add_child(layer, bitmap_layer_get_layer(info_layer->bitmap_layer_2));
-  layer_add_child(layer, text_layer_get_layer(info_layer->text_layer1));
-  layer_add_child(layer, info_layer->custom_layer);
-}
\ No newline at end of file
+  step_count_rect.size.w = (steps * step_count_rect.size.w) / s_step_goal;
+  draw_list_fill(list, step_count_rect, GColorLightGray);
+
+  draw_list_text(list, info_layer->layout[LAYOUT_STEPS_TEXT], s_step_buffer, font,
+                 get_text_color(), GTextAlignmentCenter);
+
+  // Step icon via PDC draw command
+  draw_list_icon(list, info_layer->layout[LAYOUT_STEPS_ICON], &s_step_icon, RESOURCE_ID_IMAGE_STEP);
+}
+
+const Widget steps_widget = {
+  .max_ops = 4,
+  .reads = STORE_BIT(STORE_STEPS) | STORE_BIT(STORE_STEP_GOAL),
+  .update = draw_steps_info
+};
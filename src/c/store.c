@@ -0,0 +1,64 @@
+#include "store.h"
+
+typedef struct {
+  uint8_t value[STORE_VALUE_MAX_SIZE];  // Last value reported
+  uint8_t size;
+  bool known;
+} StoreEntry;
+
+static StoreEntry s_entries[NUM_STORE_FIELDS];
+static uint32_t s_changed = 0;
+static StoreListener s_listener = NULL;
+
+static uint32_t s_commits[NUM_STORE_SOURCES];
+static uint32_t s_invalidations[NUM_STORE_SOURCES];
+
+static const char *const s_source_names[NUM_STORE_SOURCES] = {
+  "message", "battery", "tick", "connection"
+};
+
+void store_set_listener(StoreListener listener) {
+  s_listener = listener;
+}
+
+void store_set(StoreField field, const void *value, size_t size) {
+  StoreEntry *entry = &s_entries[field];
+  if (size > STORE_VALUE_MAX_SIZE) {
+    // Too large to keep, every report counts as a change
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Store field %d too large (%d bytes)", field, (int)size);
+    entry->known = false;
+  } else if (entry->known && entry->size == size && memcmp(entry->value, value, size) == 0) {
+    return;
+  } else {
+    memcpy(entry->value, value, size);
+    entry->size = size;
+    entry->known = true;
+  }
+  s_changed |= STORE_BIT(field);
+}
+
+void store_set_int(StoreField field, int value) {
+  store_set(field, &value, sizeof(value));
+}
+
+void store_set_string(StoreField field, const char *value) {
+  store_set(field, value, strlen(value));
+}
+
+void store_commit(StoreSource source) {
+  if (!s_changed) {
+    return;
+  }
+  const uint32_t changed = s_changed;
+  s_changed = 0;
+
+  s_commits[source]++;
+  s_invalidations[source] += s_listener ? s_listener(changed) : 0;
+}
+
+void store_log() {
+  for (int i = 0; i < NUM_STORE_SOURCES; i++) {
+    APP_LOG(APP_LOG_LEVEL_INFO, "Store %s: %d commits, %d invalidated",
+            s_source_names[i], (int)s_commits[i], (int)s_invalidations[i]);
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef STORE_H
+#define STORE_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Data the face shows. The values stay in their modules (buffers and
+// globals), the store keeps a copy of each field to tell which of them
+// really changed.
+typedef enum {
+  STORE_TEMPERATURE = 0,   // s_temperature_buffer (with unit)
+  STORE_LOCATION,          // s_location_buffer
+  STORE_CONDITION,         // s_current_weather_code
+  STORE_IS_DAY,            // s_is_day
+  STORE_BATTERY,           // battery_level
+  STORE_STEPS,             // step_count
+  STORE_STEP_GOAL,         // s_step_goal
+  STORE_HEART_RATE,        // heart_rate_bpm
+  STORE_DATE,              // s_day_buffer
+  STORE_LAYOUT,            // s_layer_assignments and s_disconnect_position
+  STORE_CONNECTION,        // Phone app connection
+  NUM_STORE_FIELDS
+} StoreField;
+
+#define STORE_BIT(field) (1u << (field))
+
+// Largest value kept for the comparison (the location text, the layout)
+#define STORE_VALUE_MAX_SIZE 24
+
+// Who commits changes, invalidations are counted per source
+typedef enum {
+  STORE_SOURCE_MESSAGE = 0,
+  STORE_SOURCE_BATTERY,
+  STORE_SOURCE_TICK,
+  STORE_SOURCE_CONNECTION,
+  NUM_STORE_SOURCES
+} StoreSource;
+
+// Called by store_commit with the STORE_BITs of the changed fields,
+// returns the number of dependents it invalidated
+typedef int (*StoreListener)(uint32_t changed);
+
+/*
+ * Function Declarations
+ */
+
+void store_set_listener(StoreListener listener);
+
+// Report the current value of a field. Only a value different from the
+// last one reported marks the field changed.
+void store_set(StoreField field, const void *value, size_t size);
+void store_set_int(StoreField field, int value);
+void store_set_string(StoreField field, const char *value);
+
+// Hand the fields changed since the last commit to the listener. Nothing
+// happens if no field changed.
+void store_commit(StoreSource source);
+
+// Log the commits and invalidated dependents of every source so far
+void store_log();
+
+#endif // STORE_H
@@ -0,0 +1,137 @@
+#include "timeline.h"
+#include "compositor.h"
+
+static const TimelinePhase *s_phases = NULL;
+static int s_num_phases = 0;
+static int s_num_frames = 0;
+static int s_frames_per_step = 1;
+static uint32_t s_step_ms = 0;
+
+static Animation *s_animation = NULL;
+static int s_elapsed = 0;
+static int s_step = 0;
+
+// Phases whose visible state changes on each step (bit i = phase i)
+static uint8_t s_schedule[TIMELINE_MAX_STEPS + 1];
+
+static int num_steps() {
+  int steps = (s_num_frames + s_frames_per_step - 1) / s_frames_per_step;
+  return steps > TIMELINE_MAX_STEPS ? TIMELINE_MAX_STEPS : steps;
+}
+
+static int step_to_elapsed(int step) {
+  int elapsed = step * s_frames_per_step;
+  return elapsed > s_num_frames ? s_num_frames : elapsed;
+}
+
+static int phase_state(const TimelinePhase *phase, int elapsed) {
+  if (elapsed < phase->start) elapsed = phase->start;
+  if (elapsed > phase->end) elapsed = phase->end;
+  return phase->state(elapsed);
+}
+
+// Compare the visible state of every phase between consecutive steps
+static void compute_schedule() {
+  const int steps = num_steps();
+  int skipped = 0;
+  s_schedule[0] = 0;
+  for (int step = 1; step <= steps; step++) {
+    uint8_t mask = 0;
+    for (int i = 0; i < s_num_phases; i++) {
+      if (phase_state(&s_phases[i], step_to_elapsed(step)) !=
+          phase_state(&s_phases[i], step_to_elapsed(step - 1))) {
+        mask |= 1 << i;
+      }
+    }
+    s_schedule[step] = mask;
+    if (!mask) skipped++;
+  }
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Timeline schedule: %d steps, %d without changes", steps, skipped);
+}
+
+// Only the dirty rects of the changed phases are redrawn
+static void mark_changed(uint8_t mask) {
+  for (int i = 0; i < s_num_phases; i++) {
+    if (mask & (1 << i)) {
+      compositor_mark_dirty(*s_phases[i].layer, s_phases[i].dirty);
+    }
+  }
+}
+
+static void animation_update(Animation *animation, const AnimationProgress progress) {
+  const int steps = num_steps();
+  int step = (int)((int64_t)progress * steps / ANIMATION_NORMALIZED_MAX);
+  if (step > steps) step = steps;
+  if (step <= s_step) {
+    return;
+  }
+
+  // Steps that were not shown (late frames) are folded into this one
+  uint8_t mask = 0;
+  for (int s = s_step + 1; s <= step; s++) {
+    mask |= s_schedule[s];
+  }
+  s_step = step;
+  s_elapsed = step_to_elapsed(step);
+  if (mask) {
+    mark_changed(mask);
+  }
+}
+
+static void animation_teardown(Animation *animation) {
+  s_animation = NULL;
+}
+
+static const AnimationImplementation s_implementation = {
+  .update = animation_update,
+  .teardown = animation_teardown,
+};
+
+void timeline_init(const TimelinePhase *phases, int num_phases, int num_frames,
+                   int frames_per_step, uint32_t step_ms) {
+  s_phases = phases;
+  s_num_phases = num_phases > TIMELINE_MAX_PHASES ? TIMELINE_MAX_PHASES : num_phases;
+  s_num_frames = num_frames;
+  s_frames_per_step = frames_per_step;
+  s_step_ms = step_ms;
+  s_elapsed = num_frames;
+  s_step = num_steps();
+}
+
+void timeline_play(uint32_t delay_ms) {
+  if (s_animation) {
+    return;
+  }
+
+  compute_schedule();
+  s_step = 0;
+  s_elapsed = 0;
+  // Everything starts over from the first frame
+  mark_changed((1 << s_num_phases) - 1);
+
+  s_animation = animation_create();
+  animation_set_implementation(s_animation, &s_implementation);
+  animation_set_delay(s_animation, delay_ms);
+  animation_set_duration(s_animation, num_steps() * s_step_ms);
+  animation_set_curve(s_animation, AnimationCurveLinear);
+  animation_schedule(s_animation);
+}
+
+void timeline_finish() {
+  if (s_animation) {
+    animation_unschedule(s_animation);
+    // The teardown handler clears s_animation, animations are destroyed
+    // by the system once unscheduled
+  }
+  s_animation = NULL;
+  s_step = num_steps();
+  s_elapsed = s_num_frames;
+}
+
+int timeline_elapsed() {
+  return s_elapsed;
+}
+
+bool timeline_is_running() {
+  return s_animation != NULL;
+}
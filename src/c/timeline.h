@@ -0,0 +1,45 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <pebble.h>
+
+/*
+ * Definitions
+ */
+
+// Upper bound for the number of steps of a timeline
+#define TIMELINE_MAX_STEPS 64
+#define TIMELINE_MAX_PHASES 8
+
+// One phase of a timeline. Times are in frames since the start.
+typedef struct {
+  int start;
+  int end;
+  Layer **layer;              // Layer that shows the phase
+  GRect dirty;                // Part of that layer which changes during the phase
+  int (*state)(int elapsed);  // Visible state of the phase at a frame (clamped to start..end)
+} TimelinePhase;
+
+/*
+ * Function Declarations
+ */
+
+// Set up the timeline: num_frames frames played in steps of frames_per_step,
+// one step every step_ms
+void timeline_init(const TimelinePhase *phases, int num_phases, int num_frames,
+                   int frames_per_step, uint32_t step_ms);
+
+// Play the timeline from the start after delay_ms, unless it is already
+// running. The frame schedule is computed up front: a layer is only marked
+// dirty on the steps where the state of one of its phases changes.
+void timeline_play(uint32_t delay_ms);
+
+// Stop the timeline and jump to its end
+void timeline_finish();
+
+// Frames played so far, read by the draw procs
+int timeline_elapsed();
+
+bool timeline_is_running();
+
+#endif // TIMELINE_H
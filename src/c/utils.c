@@ -1,48 +1,197 @@
 #include "utils.h"
+#include "arena.h"
+#include "memstats.h"
+#include "pdc.h"
 
-void load_pdc_icon(GDrawCommandImage **icon, uint32_t resource_id, int orig_icon_size, int target_icon_size) {
-  if (*icon) {
-    gdraw_command_image_destroy(*icon);
+// Icons loaded through load_pdc_icon: the arena block each keeps for its
+// reloads, or whether it was loaded through the SDK into the heap, and
+// whether black and white are currently swapped in it (dark theme)
+#define MAX_THEMED_ICONS 12
+typedef struct {
+  GDrawCommandImage **icon;
+  void *block;
+  bool heap;
+  bool inverted;
+} ThemedIcon;
+static ThemedIcon s_themed_icons[MAX_THEMED_ICONS];
+static int s_num_themed_icons = 0;
+
+// Set once an icon copied into the arena did not read back as its file
+// declares it, all icons are loaded through the SDK afterwards
+static bool s_sdk_load = false;
+
+// Swap black and white in all commands of the image. Applying it twice
+// restores the original colors.
+static void swap_black_white(GDrawCommandImage *image) {
+  GDrawCommandList *list = gdraw_command_image_get_command_list(image);
+  int num_commands = gdraw_command_list_get_num_commands(list);
+  for (int i = 0; i < num_commands; i++) {
+    GDrawCommand *cmd = gdraw_command_list_get_command(list, i);
+    GColor stroke = gdraw_command_get_stroke_color(cmd);
+    if (gcolor_equal(stroke, GColorBlack)) {
+      gdraw_command_set_stroke_color(cmd, GColorWhite);
+    } else if (gcolor_equal(stroke, GColorWhite)) {
+      gdraw_command_set_stroke_color(cmd, GColorBlack);
+    }
+    GColor fill = gdraw_command_get_fill_color(cmd);
+    if (gcolor_equal(fill, GColorBlack)) {
+      gdraw_command_set_fill_color(cmd, GColorWhite);
+    } else if (gcolor_equal(fill, GColorWhite)) {
+      gdraw_command_set_fill_color(cmd, GColorBlack);
+    }
+  }
+}
+
+static ThemedIcon *themed_icon(GDrawCommandImage **icon) {
+  for (int i = 0; i < s_num_themed_icons; i++) {
+    if (s_themed_icons[i].icon == icon) {
+      return &s_themed_icons[i];
+    }
+  }
+  if (s_num_themed_icons >= MAX_THEMED_ICONS) {
+    APP_LOG(APP_LOG_LEVEL_ERROR, "Too many icons");
+    return NULL;
   }
-  *icon = gdraw_command_image_create_with_resource(resource_id);
+  ThemedIcon *entry = &s_themed_icons[s_num_themed_icons++];
+  memset(entry, 0, sizeof(*entry));
+  entry->icon = icon;
+  return entry;
+}
 
-  scale_pdc(*icon, orig_icon_size, target_icon_size);
+// Copy the image after the file header into the icon's arena block. The
+// PDC file format is documented by the SDK and the image data is what
+// gdraw_command_image_create_with_resource copies into its heap block and
+// draws in place. The copy is checked against the SDK getters; if they do
+// not report the view box and command count of the file, this firmware
+// keeps images differently and the SDK loader is used from then on.
+// tests/test_arena.c checks every icon resource against the format and the
+// block size.
+static GDrawCommandImage *load_into_arena(ThemedIcon *entry, uint32_t resource_id) {
+  ResHandle handle = resource_get_handle(resource_id);
+  const size_t size = resource_size(handle);
+  uint8_t header[PDC_HEADER_SIZE];
+  if (size <= PDC_HEADER_SIZE ||
+      resource_load_byte_range(handle, 0, header, PDC_HEADER_SIZE) != PDC_HEADER_SIZE) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Icon %d is not a PDC image", (int)resource_id);
+    return NULL;
+  }
+  const int image_size = pdc_image_size(header, size);
+  if (image_size < 0) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Icon %d is not a PDC image", (int)resource_id);
+    return NULL;
+  }
+  if (image_size > ARENA_ICON_SIZE) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Icon %d does not fit an arena block (%d bytes)",
+            (int)resource_id, image_size);
+    return NULL;
+  }
+
+  // Every icon keeps the arena block it got on its first load, reloads
+  // (weather changes) overwrite it in place
+  if (!entry->block) {
+    entry->block = arena_alloc(ARENA_ICON_SIZE);
+    if (!entry->block) {
+      return NULL;
+    }
+    memstats_count(MEMSTATS_ICONS, ARENA_ICON_SIZE);
+  }
+  resource_load_byte_range(handle, PDC_HEADER_SIZE, entry->block, image_size);
+  PdcInfo info;
+  if (!pdc_parse(entry->block, image_size, &info)) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Icon %d is not a valid PDC image", (int)resource_id);
+    return NULL;
+  }
+
+  GDrawCommandImage *image = entry->block;
+  const GSize bounds = gdraw_command_image_get_bounds_size(image);
+  const int num_commands = gdraw_command_list_get_num_commands(gdraw_command_image_get_command_list(image));
+  if (bounds.w != info.width || bounds.h != info.height || num_commands != info.num_commands) {
+    APP_LOG(APP_LOG_LEVEL_ERROR, "Icon %d reads back differently, loading icons through the SDK",
+            (int)resource_id);
+    s_sdk_load = true;
+    return NULL;
+  }
+  return image;
+}
+
+void load_pdc_icon(GDrawCommandImage **icon, uint32_t resource_id) {
+  ThemedIcon *entry = themed_icon(icon);
+  if (!entry) {
+    *icon = NULL;
+    return;
+  }
+
+  // A failed (re)load leaves no icon rather than the previous one
+  if (entry->heap && *icon) {
+    gdraw_command_image_destroy(*icon);
+  }
+  entry->heap = false;
+  *icon = s_sdk_load ? NULL : load_into_arena(entry, resource_id);
+  if (s_sdk_load) {
+    *icon = gdraw_command_image_create_with_resource(resource_id);
+    entry->heap = *icon != NULL;
+  }
+  if (!*icon) {
+    return;
+  }
 
   // In dark theme, invert black↔white; in light theme, PDC colors are already correct
-  if (!is_light_theme()) {
-    GDrawCommandList *list = gdraw_command_image_get_command_list(*icon);
-    int num_commands = gdraw_command_list_get_num_commands(list);
-    for (int i = 0; i < num_commands; i++) {
-      GDrawCommand *cmd = gdraw_command_list_get_command(list, i);
-      GColor stroke = gdraw_command_get_stroke_color(cmd);
-      if (gcolor_equal(stroke, GColorBlack)) {
-        gdraw_command_set_stroke_color(cmd, GColorWhite);
-      } else if (gcolor_equal(stroke, GColorWhite)) {
-        gdraw_command_set_stroke_color(cmd, GColorBlack);
-      }
-      GColor fill = gdraw_command_get_fill_color(cmd);
-      if (gcolor_equal(fill, GColorBlack)) {
-        gdraw_command_set_fill_color(cmd, GColorWhite);
-      } else if (gcolor_equal(fill, GColorWhite)) {
-        gdraw_command_set_fill_color(cmd, GColorBlack);
-      }
+  entry->inverted = !is_light_theme();
+  if (entry->inverted) {
+    swap_black_white(*icon);
+  }
+}
+
+void release_pdc_icons() {
+  for (int i = 0; i < s_num_themed_icons; i++) {
+    if (s_themed_icons[i].heap && *s_themed_icons[i].icon) {
+      gdraw_command_image_destroy(*s_themed_icons[i].icon);
     }
+    *s_themed_icons[i].icon = NULL;
   }
+  s_num_themed_icons = 0;
 }
 
-void scale_pdc(GDrawCommandImage *image, int original_size, int new_size) {
-  gdraw_command_image_set_bounds_size(image, GSize(new_size, new_size));
-  GDrawCommandList *list = gdraw_command_image_get_command_list(image);
-  int num_commands = gdraw_command_list_get_num_commands(list);
-  for (int i = 0; i < num_commands; i++) {
-    GDrawCommand *cmd = gdraw_command_list_get_command(list, i);
-    int num_points = gdraw_command_get_num_points(cmd);
-    for (int j = 0; j < num_points; j++) {
-      GPoint pt = gdraw_command_get_point(cmd, j);
-      pt.x = pt.x * new_size / original_size;
-      pt.y = pt.y * new_size / original_size;
-      gdraw_command_set_point(cmd, j, pt);
+void update_pdc_icon_colors() {
+  bool inverted = !is_light_theme();
+  for (int i = 0; i < s_num_themed_icons; i++) {
+    GDrawCommandImage *image = *s_themed_icons[i].icon;
+    if (image && s_themed_icons[i].inverted != inverted) {
+      swap_black_white(image);
+      s_themed_icons[i].inverted = inverted;
     }
   }
 }
 
+// Draw text in the theme colors. In light mode the black text gets a white
+// 1px outline by drawing it 4 times with 1-pixel offsets first.
+void draw_theme_text(GContext *ctx, const char *text, GFont font, GRect bounds, GTextAlignment alignment, bool light) {
+  if (light) {
+    graphics_context_set_text_color(ctx, GColorWhite);
+
+    // Left
+    graphics_draw_text(ctx, text, font,
+                      GRect(bounds.origin.x - 1, bounds.origin.y, bounds.size.w, bounds.size.h),
+                      GTextOverflowModeWordWrap, alignment, NULL);
+    // Right
+    graphics_draw_text(ctx, text, font,
+                      GRect(bounds.origin.x + 1, bounds.origin.y, bounds.size.w, bounds.size.h),
+                      GTextOverflowModeWordWrap, alignment, NULL);
+    // Up
+    graphics_draw_text(ctx, text, font,
+                      GRect(bounds.origin.x, bounds.origin.y - 1, bounds.size.w, bounds.size.h),
+                      GTextOverflowModeWordWrap, alignment, NULL);
+    // Down
+    graphics_draw_text(ctx, text, font,
+                      GRect(bounds.origin.x, bounds.origin.y + 1, bounds.size.w, bounds.size.h),
+                      GTextOverflowModeWordWrap, alignment, NULL);
+
+    // Draw black text in center
+    graphics_context_set_text_color(ctx, GColorBlack);
+    graphics_draw_text(ctx, text, font, bounds, GTextOverflowModeWordWrap, alignment, NULL);
+  } else {
+    // Dark mode: just draw white text without outline
+    graphics_context_set_text_color(ctx, GColorWhite);
+    graphics_draw_text(ctx, text, font, bounds, GTextOverflowModeWordWrap, alignment, NULL);
+  }
+}
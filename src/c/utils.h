@@ -4,7 +4,15 @@
 #include <pebble.h>
 #include "config.h"
 
-extern void scale_pdc(GDrawCommandImage *image, int original_size, int new_size);
-void load_pdc_icon(GDrawCommandImage **icon, uint32_t resource_id, int orig_icon_size, int target_icon_size);
+// Load a PDC icon in the theme colors. Resources are already scaled for the
+// platform at build time (see wscript). The image lives in a block of the
+// window arena, which is reused when the same icon is loaded again. Sets
+// icon to NULL if the resource can not be loaded.
+void load_pdc_icon(GDrawCommandImage **icon, uint32_t resource_id);
+// Drop all loaded icons (sets them to NULL) before the arena is reset
+void release_pdc_icons();
+// Recolor all loaded icons for the current theme without reloading them
+void update_pdc_icon_colors();
+void draw_theme_text(GContext *ctx, const char *text, GFont font, GRect bounds, GTextAlignment alignment, bool light);
 
-#endif // UTILS_H
\ No newline at end of file
+#endif // UTILS_H
@@ -1,5 +1,6 @@
 #include "weather.h"
 #include "utils.h"
+#include "journal.h"
 
 
 /*
@@ -7,80 +8,53 @@
  */
 int s_current_weather_code = -1; // -1 indicates no weather data yet
 GDrawCommandImage *s_weather_icon = NULL;
+static uint32_t s_weather_icon_resource = 0;
 char s_temperature_buffer[8];
 char s_location_buffer[20];
 
  /*
   * Draw Functions
   */
-static void weather_icon_layer_update_proc(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
-  GPoint origin = GPoint((bounds.size.w - gdraw_command_image_get_bounds_size(s_weather_icon).w) / 2,
-                         (bounds.size.h - gdraw_command_image_get_bounds_size(s_weather_icon).h) / 2);
-  gdraw_command_image_draw(ctx, s_weather_icon, origin);
+static void draw_weather_info(InfoLayer* info_layer) {
+  // Weather icon via PDC draw command
+  draw_list_icon(&info_layer->draw_list, info_layer->layout[LAYOUT_WEATHER_ICON],
+                 &s_weather_icon, s_weather_icon_resource);
 }
 
-void draw_weather_info(InfoLayer* info_layer) {
-  Layer* layer = info_layer->layer;
-  GRect bounds = layer_get_bounds(layer);
-  int y_pos = bounds.size.h / 2 - WEATHER_ICON_SIZE / 2;
-  int x_pos = (bounds.size.w / 2) - WEATHER_ICON_SIZE / 2;
+const Widget weather_widget = {
+  .max_ops = 1,
+  .reads = STORE_BIT(STORE_CONDITION) | STORE_BIT(STORE_IS_DAY),
+  .update = draw_weather_info
+};
 
-  // Create weather icon layer via PDC draw command
-  info_layer->custom_layer = layer_create(GRect(x_pos, y_pos, WEATHER_ICON_SIZE, WEATHER_ICON_SIZE));
-  layer_set_update_proc(info_layer->custom_layer, weather_icon_layer_update_proc);
+static void draw_temperature_info(InfoLayer* info_layer) {
+  DrawList *list = &info_layer->draw_list;
 
-  // Add to the info layer
-  layer_add_child(layer, info_layer->custom_layer);
-}
-
-void draw_temperature_info(InfoLayer* info_layer) {
-  GRect bounds = info_layer->bounds;
-  Layer* layer = info_layer->layer;
-  int y_center = bounds.size.h / 2 - 10;
-  
-  // Create temperature text layer
+  // Temperature text
 #if defined(PBL_PLATFORM_EMERY)
-  GRect temp_frame = GRect(0, y_center-16, bounds.size.w, 28);
+  GFont temp_font = fonts_get_system_font(FONT_KEY_GOTHIC_28_BOLD);
 #else
-  GRect temp_frame = GRect(0, y_center-14, bounds.size.w, 24);
+  GFont temp_font = fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD);
 #endif
-  info_layer->text_layer1 = text_layer_create(temp_frame);
-  text_layer_set_background_color(info_layer->text_layer1, GColorClear);
-  text_layer_set_text_color(info_layer->text_layer1, get_text_color());
-  text_layer_set_text(info_layer->text_layer1, s_temperature_buffer);
+  draw_list_text(list, info_layer->layout[LAYOUT_TEMPERATURE_TEXT], s_temperature_buffer, temp_font,
+                 get_text_color(), GTextAlignmentCenter);
 
+  // Location text
 #if defined(PBL_PLATFORM_EMERY)
-  text_layer_set_font(info_layer->text_layer1, fonts_get_system_font(FONT_KEY_GOTHIC_28_BOLD));
-#else
-  text_layer_set_font(info_layer->text_layer1, fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD));
-#endif
-
-  // Create location text layer
-#if defined(PBL_PLATFORM_EMERY)
-  GRect location_frame = GRect(0, y_center+12, bounds.size.w, 24);
-#else
-  GRect location_frame = GRect(0, y_center+8, bounds.size.w, 18);
-#endif
-  info_layer->text_layer2 = text_layer_create(location_frame);
-  text_layer_set_background_color(info_layer->text_layer2, GColorClear);
-  text_layer_set_text_color(info_layer->text_layer2, get_text_color());
-  text_layer_set_text(info_layer->text_layer2, s_location_buffer);
-#if defined(PBL_PLATFORM_EMERY)
-  text_layer_set_font(info_layer->text_layer2, fonts_get_system_font(FONT_KEY_GOTHIC_18));
+  GFont location_font = fonts_get_system_font(FONT_KEY_GOTHIC_18);
 #else
-  text_layer_set_font(info_layer->text_layer2, fonts_get_system_font(FONT_KEY_GOTHIC_14));
+  GFont location_font = fonts_get_system_font(FONT_KEY_GOTHIC_14);
 #endif
-  
-  // Set alignment based on layer alignment
-  text_layer_set_text_alignment(info_layer->text_layer1, GTextAlignmentCenter);
-  text_layer_set_text_alignment(info_layer->text_layer2, GTextAlignmentCenter);
-
-  // Add to the info layer
-  layer_add_child(layer, text_layer_get_layer(info_layer->text_layer1));
-  layer_add_child(layer, text_layer_get_layer(info_layer->text_layer2));
+  draw_list_text(list, info_layer->layout[LAYOUT_LOCATION_TEXT], s_location_buffer, location_font,
+                 get_text_color(), GTextAlignmentCenter);
 }
 
+const Widget temperature_widget = {
+  .max_ops = 2,
+  .reads = STORE_BIT(STORE_TEMPERATURE) | STORE_BIT(STORE_LOCATION),
+  .update = draw_temperature_info
+};
+
 uint32_t get_weather_image_resource(int weather_code, bool force_day) {
 
   // Handle error case with question mark icon
@@ -122,9 +96,28 @@ uint32_t get_weather_image_resource(int weather_code, bool force_day) {
   return RESOURCE_ID_IMAGE_QUESTION; // Unknown
 }
 
+// The forecast bar uses the same icons, built at a smaller size
+uint32_t get_forecast_image_resource(int weather_code, bool force_day) {
+  switch (get_weather_image_resource(weather_code, force_day)) {
+    case RESOURCE_ID_IMAGE_SUNNY: return RESOURCE_ID_IMAGE_FORECAST_SUNNY;
+    case RESOURCE_ID_IMAGE_CLEAR_NIGHT: return RESOURCE_ID_IMAGE_FORECAST_CLEAR_NIGHT;
+    case RESOURCE_ID_IMAGE_PARTLY_CLOUDY: return RESOURCE_ID_IMAGE_FORECAST_PARTLY_CLOUDY;
+    case RESOURCE_ID_IMAGE_PARTLY_CLOUDY_NIGHT: return RESOURCE_ID_IMAGE_FORECAST_PARTLY_CLOUDY_NIGHT;
+    case RESOURCE_ID_IMAGE_CLOUDY: return RESOURCE_ID_IMAGE_FORECAST_CLOUDY;
+    case RESOURCE_ID_IMAGE_LIGHT_RAIN: return RESOURCE_ID_IMAGE_FORECAST_LIGHT_RAIN;
+    case RESOURCE_ID_IMAGE_HEAVY_RAIN: return RESOURCE_ID_IMAGE_FORECAST_HEAVY_RAIN;
+    case RESOURCE_ID_IMAGE_LIGHT_SNOW: return RESOURCE_ID_IMAGE_FORECAST_LIGHT_SNOW;
+    case RESOURCE_ID_IMAGE_HEAVY_SNOW: return RESOURCE_ID_IMAGE_FORECAST_HEAVY_SNOW;
+    case RESOURCE_ID_IMAGE_RAIN_SNOW: return RESOURCE_ID_IMAGE_FORECAST_RAIN_SNOW;
+    case RESOURCE_ID_IMAGE_THUNDERSTORM: return RESOURCE_ID_IMAGE_FORECAST_THUNDERSTORM;
+    default: return RESOURCE_ID_IMAGE_FORECAST_QUESTION;
+  }
+}
+
 void load_weather_icon() {
   uint32_t resource_id = get_weather_image_resource(s_current_weather_code, false);
-  load_pdc_icon(&s_weather_icon, resource_id, ORIG_WEATHER_ICON_SIZE, WEATHER_ICON_SIZE);
+  load_pdc_icon(&s_weather_icon, resource_id);
+  s_weather_icon_resource = resource_id;
 }
 
 /*
@@ -148,45 +141,105 @@ void request_weather_update() {
 /*
  * Storage of weather 
  */
+// Current weather in one persisted blob, versioned like the settings
+#define WEATHER_BLOB_VERSION 1
+
+typedef struct __attribute__((packed)) {
+  uint8_t version;
+  int8_t weather_code;
+  uint8_t is_day;
+  char temperature[8];
+  char location[20];
+} WeatherBlob;
+
+static size_t pack_weather(void *buffer) {
+  WeatherBlob *blob = buffer;
+  memset(blob, 0, sizeof(*blob));
+  blob->version = WEATHER_BLOB_VERSION;
+  blob->weather_code = s_current_weather_code;
+  blob->is_day = s_is_day;
+  strncpy(blob->temperature, s_temperature_buffer, sizeof(blob->temperature) - 1);
+  strncpy(blob->location, s_location_buffer, sizeof(blob->location) - 1);
+  return sizeof(*blob);
+}
+
+// Written behind by the journal, and only if the weather really changed
 void save_weather_to_storage() {
-  persist_write_int(PERSIST_KEY_WEATHER_CODE, s_current_weather_code);
-  persist_write_string(PERSIST_KEY_TEMPERATURE, s_temperature_buffer);
-  persist_write_string(PERSIST_KEY_LOCATION, s_location_buffer);
-  persist_write_int(PERSIST_KEY_IS_DAY, s_is_day);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved weather to storage: code=%d, temp=%s, location=%s", 
-          s_current_weather_code, s_temperature_buffer, s_location_buffer);
+  journal_mark(PERSIST_KEY_WEATHER);
 }
 
-void load_weather_from_storage() {
-  // Load weather code
+// Read the weather from the keys before the blob
+static void read_legacy_weather() {
   if (persist_exists(PERSIST_KEY_WEATHER_CODE)) {
     s_current_weather_code = persist_read_int(PERSIST_KEY_WEATHER_CODE);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded weather code from storage: %d", s_current_weather_code);
   }
-  
-  // Load temperature
   if (persist_exists(PERSIST_KEY_TEMPERATURE)) {
     persist_read_string(PERSIST_KEY_TEMPERATURE, s_temperature_buffer, sizeof(s_temperature_buffer));
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded temperature from storage: %s", s_temperature_buffer);
-  } else {
-    // Use the current temperature unit for the default display
-    const char* unit_symbol = s_temperature_unit == 1 ? "°F" : "°C";
-    snprintf(s_temperature_buffer, sizeof(s_temperature_buffer), "---%s", unit_symbol);
   }
-  
-  // Load location
   if (persist_exists(PERSIST_KEY_LOCATION)) {
     persist_read_string(PERSIST_KEY_LOCATION, s_location_buffer, sizeof(s_location_buffer));
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded location from storage: %s", s_location_buffer);
-  } else {
-    snprintf(s_location_buffer, sizeof(s_location_buffer), "---");
   }
-
-  // Load is_day
   if (persist_exists(PERSIST_KEY_IS_DAY)) {
     s_is_day = persist_read_int(PERSIST_KEY_IS_DAY);
-    APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded is_day from storage: %d", s_is_day);
-  } else {
-    s_is_day = 1; // Default to day
   }
-}
\ No newline at end of file
+}
+
+// Called whenever a valid blob is stored, so keys left by a migration whose
+// write failed are cleaned up on a later start
+static void delete_legacy_weather() {
+  const uint32_t keys[] = {
+    PERSIST_KEY_WEATHER_CODE, PERSIST_KEY_TEMPERATURE, PERSIST_KEY_LOCATION, PERSIST_KEY_IS_DAY
+  };
+  for (unsigned i = 0; i < ARRAY_LENGTH(keys); i++) {
+    if (persist_exists(keys[i])) {
+      persist_delete(keys[i]);
+    }
+  }
+}
+
+void load_weather_from_storage() {
+  // Defaults until the first weather update: no data, day, unit placeholder
+  const char* unit_symbol = s_temperature_unit == 1 ? "°F" : "°C";
+  snprintf(s_temperature_buffer, sizeof(s_temperature_buffer), "---%s", unit_symbol);
+  snprintf(s_location_buffer, sizeof(s_location_buffer), "---");
+  s_is_day = 1;
+
+  if (!persist_exists(PERSIST_KEY_WEATHER)) {
+    // First start with the blob: move the weather over from its old keys,
+    // which are only deleted once the blob reads back valid
+    read_legacy_weather();
+    WeatherBlob blob;
+    const size_t size = pack_weather(&blob);
+    if (persist_write_data(PERSIST_KEY_WEATHER, &blob, size) != (int)size) {
+      APP_LOG(APP_LOG_LEVEL_ERROR, "Could not migrate weather, keeping old keys");
+      journal_register_packed(PERSIST_KEY_WEATHER, pack_weather, sizeof(WeatherBlob),
+                              NULL, 0);
+      return;
+    }
+    journal_register_packed(PERSIST_KEY_WEATHER, pack_weather, sizeof(WeatherBlob),
+                            &blob, size);
+    delete_legacy_weather();
+    return;
+  }
+
+  WeatherBlob blob;
+  memset(&blob, 0, sizeof(blob));
+  const int size = persist_read_data(PERSIST_KEY_WEATHER, &blob, sizeof(blob));
+  journal_register_packed(PERSIST_KEY_WEATHER, pack_weather, sizeof(WeatherBlob),
+                          &blob, size > 0 ? size : 0);
+  if (size > 0 && blob.version == WEATHER_BLOB_VERSION) {
+    delete_legacy_weather();
+  }
+  s_current_weather_code = blob.weather_code;
+  s_is_day = blob.is_day;
+  if (blob.temperature[0]) {
+    memcpy(s_temperature_buffer, blob.temperature, sizeof(s_temperature_buffer));
+    s_temperature_buffer[sizeof(s_temperature_buffer) - 1] = '\0';
+  }
+  if (blob.location[0]) {
+    memcpy(s_location_buffer, blob.location, sizeof(s_location_buffer));
+    s_location_buffer[sizeof(s_location_buffer) - 1] = '\0';
+  }
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded weather from storage: code=%d, temp=%s, location=%s",
+          s_current_weather_code, s_temperature_buffer, s_location_buffer);
+}
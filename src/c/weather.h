@@ -3,30 +3,25 @@
 
 #include <pebble.h>
 #include "config.h"
+#include "widget.h"
 
 
 /*
  * Definitions
  */
 
-#define ORIG_WEATHER_ICON_SIZE 50
-#if defined(PBL_PLATFORM_EMERY)
-  #define WEATHER_ICON_SIZE 50
-#else
-  #define WEATHER_ICON_SIZE 36
-#endif
-
 extern int s_current_weather_code;
 extern GDrawCommandImage *s_weather_icon;
 extern char s_temperature_buffer[8];
 extern char s_location_buffer[20];
+extern const Widget weather_widget;
+extern const Widget temperature_widget;
 
 /*
  * Function Declarations
  */
-void draw_weather_info(InfoLayer* info_layer);
-void draw_temperature_info(InfoLayer* info_layer);
 uint32_t get_weather_image_resource(int weather_code, bool force_day);
+uint32_t get_forecast_image_resource(int weather_code, bool force_day);
 void load_weather_icon();
 void request_weather_update();
 void save_weather_to_storage();
@@ -3,18 +3,62 @@
 #include "config.h"
 #include "weather.h"
 #include "utils.h"
+#include "raster.h"
+#include "outline_text.h"
+#include "icon_cache.h"
+#include "memstats.h"
+#include "journal.h"
+#include "fixed.h"
+#include "bitmap_cache.h"
+#include "compositor.h"
 
 static Layer *s_forecast_top_layer = NULL;
 static Layer *s_forecast_bottom_layer = NULL;
+static Layer *s_scene_layer = NULL;
 static AppTimer *s_hide_timer = NULL;
+static AppTimer *s_prerender_timer = NULL;
 
 // Slide animation state
 static PropertyAnimation *s_top_anim = NULL;
 static PropertyAnimation *s_bottom_anim = NULL;
 static bool s_is_visible = false;
+// Visible state as persisted, restored on the next start
+static bool s_saved_visible = false;
 static bool s_is_animating = false;
+static bool s_holding_scene = false;
 static GRect s_screen_bounds;
 
+// Framebuffer slide: a full screen layer on top blits the pre-rendered
+// panels at the current offset while the scene below is hidden and the
+// framebuffer keeps the previous frame. s_scene_top/bottom hold the scene
+// under the shown panels, to restore the rows a hiding panel uncovers.
+static Layer *s_slide_layer = NULL;
+static Animation *s_slide_anim = NULL;
+static AnimationProgress s_slide_progress = 0;
+static bool s_slide_show = false;
+static bool s_slide_drawn = false;
+static bool s_slide_retained = false;
+static GRect s_slide_prev_top;
+static GRect s_slide_prev_bottom;
+static GBitmap *s_scene_top = NULL;
+static GBitmap *s_scene_bottom = NULL;
+
+// Layers hidden while the settled panels cover them
+static Layer *s_occluded_layers[WEATHER_FORECAST_MAX_OCCLUDED];
+static int s_num_occluded_layers = 0;
+static bool s_occluding = false;
+
+// Notified when the panels come up or are gone again
+static WeatherForecastOverlayHandler s_overlay_handler = NULL;
+static bool s_overlay_up = false;
+
+// Pre-rendered panels. s_data_version changes with every data update and
+// is part of the cache keys.
+static BitmapCache s_top_cache;
+static BitmapCache s_bottom_cache;
+static uint16_t s_data_version = 0;
+static int s_current_hour = 0;
+
 // Forecast data
 ForecastSlot s_forecast[NUM_FORECAST_SLOTS] = {
   { .temperature = 0, .condition_code = -1 },
@@ -24,6 +68,7 @@ ForecastSlot s_forecast[NUM_FORECAST_SLOTS] = {
 
 // Forecast icons (PDC images)
 static GDrawCommandImage *s_forecast_icons[NUM_FORECAST_SLOTS] = { NULL, NULL, NULL };
+static uint32_t s_forecast_icon_resources[NUM_FORECAST_SLOTS];
 
 // Temperature label buffers
 static char s_forecast_temp_buffers[NUM_FORECAST_SLOTS][10];
@@ -36,13 +81,6 @@ int s_hourly_temps[NUM_HOURLY_POINTS] = {0};
 int s_hourly_precip[NUM_HOURLY_POINTS] = {0};
 bool s_hourly_data_available = false;
 
-#define FORECAST_ICON_ORIG_SIZE 50
-#if defined(PBL_PLATFORM_EMERY)
-  #define FORECAST_ICON_SIZE 30
-#else
-  #define FORECAST_ICON_SIZE 20
-#endif
-
 // Returns auto-hide delay in ms, or 0 for "forever" (no auto-hide).
 static int forecast_display_ms(void) {
   switch (s_weather_forecast_duration) {
@@ -58,13 +96,15 @@ static int forecast_display_ms(void) {
 void weather_forecast_update_icons() {
   for (int i = 0; i < NUM_FORECAST_SLOTS; i++) {
     bool force_day = (i > 0); // +1d and +2d are always day icons
-    uint32_t resource_id = get_weather_image_resource(s_forecast[i].condition_code, force_day);
-    load_pdc_icon(&s_forecast_icons[i], resource_id, FORECAST_ICON_ORIG_SIZE, FORECAST_ICON_SIZE);
+    uint32_t resource_id = get_forecast_image_resource(s_forecast[i].condition_code, force_day);
+    load_pdc_icon(&s_forecast_icons[i], resource_id);
+    s_forecast_icon_resources[i] = resource_id;
 
     const char *unit = s_temperature_unit == 1 ? "F" : "C";
     snprintf(s_forecast_temp_buffers[i], sizeof(s_forecast_temp_buffers[i]),
              "%d°%s", s_forecast[i].temperature, unit);
   }
+  s_data_version++;
 }
 
 // Parse comma-separated integers into an array, returns count parsed
@@ -90,6 +130,7 @@ void weather_forecast_parse_hourly_temps(const char *csv) {
   if (csv && csv[0]) {
     parse_csv_ints(csv, s_hourly_temps, NUM_HOURLY_POINTS);
     s_hourly_data_available = true;
+    s_data_version++;
   }
   weather_forecast_save_data();
 }
@@ -97,16 +138,25 @@ void weather_forecast_parse_hourly_temps(const char *csv) {
 void weather_forecast_parse_hourly_precip(const char *csv) {
   if (csv && csv[0]) {
     parse_csv_ints(csv, s_hourly_precip, NUM_HOURLY_POINTS);
+    s_data_version++;
   }
   weather_forecast_save_data();
 }
 
+// Written behind by the journal, each block only if it changed
 void weather_forecast_save_data() {
-  persist_write_data(PERSIST_KEY_FORECAST_DATA, s_forecast, sizeof(s_forecast));
-  persist_write_data(PERSIST_KEY_HOURLY_TEMPS, s_hourly_temps, sizeof(s_hourly_temps));
-  persist_write_data(PERSIST_KEY_HOURLY_PRECIP, s_hourly_precip, sizeof(s_hourly_precip));
-  persist_write_bool(PERSIST_KEY_HOURLY_DATA_AVAILABLE, s_hourly_data_available);
-  APP_LOG(APP_LOG_LEVEL_DEBUG, "Saved forecast data to storage");
+  journal_mark(PERSIST_KEY_FORECAST_DATA);
+  journal_mark(PERSIST_KEY_HOURLY_TEMPS);
+  journal_mark(PERSIST_KEY_HOURLY_PRECIP);
+  journal_mark(PERSIST_KEY_HOURLY_DATA_AVAILABLE);
+}
+
+// The journal stores the flags as raw data (one byte), read them back the
+// same way instead of with persist_read_bool
+static bool read_flag(uint32_t key) {
+  uint8_t value = 0;
+  persist_read_data(key, &value, sizeof(value));
+  return value != 0;
 }
 
 void weather_forecast_load_data() {
@@ -123,51 +173,45 @@ void weather_forecast_load_data() {
     APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded hourly precip from storage");
   }
   if (persist_exists(PERSIST_KEY_HOURLY_DATA_AVAILABLE)) {
-    s_hourly_data_available = persist_read_bool(PERSIST_KEY_HOURLY_DATA_AVAILABLE);
+    s_hourly_data_available = read_flag(PERSIST_KEY_HOURLY_DATA_AVAILABLE);
     APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded hourly data available from storage");
   }
+  journal_register_data(PERSIST_KEY_FORECAST_DATA, s_forecast, sizeof(s_forecast),
+                        persist_exists(PERSIST_KEY_FORECAST_DATA));
+  journal_register_data(PERSIST_KEY_HOURLY_TEMPS, s_hourly_temps, sizeof(s_hourly_temps),
+                        persist_exists(PERSIST_KEY_HOURLY_TEMPS));
+  journal_register_data(PERSIST_KEY_HOURLY_PRECIP, s_hourly_precip, sizeof(s_hourly_precip),
+                        persist_exists(PERSIST_KEY_HOURLY_PRECIP));
+  journal_register_data(PERSIST_KEY_HOURLY_DATA_AVAILABLE, &s_hourly_data_available,
+                        sizeof(s_hourly_data_available), persist_exists(PERSIST_KEY_HOURLY_DATA_AVAILABLE));
   weather_forecast_update_icons();
 }
 
-// Draw text with a 1px outline (background color border, then foreground in center)
-static void draw_outlined_text(GContext *ctx, const char *text, GFont font,
+// Draw text with a 1px outline (background color border, foreground in center)
+static void draw_outlined_text(GContext *ctx, Layer *layer, const char *text, GFont font,
                                GRect rect, GTextOverflowMode overflow,
                                GTextAlignment alignment, GColor fg_color) {
-  GColor outline_color = get_background_color();
-  graphics_context_set_text_color(ctx, outline_color);
-  // Draw outline: 4 offsets
-  graphics_draw_text(ctx, text, font, GRect(rect.origin.x - 1, rect.origin.y, rect.size.w, rect.size.h), overflow, alignment, NULL);
-  graphics_draw_text(ctx, text, font, GRect(rect.origin.x + 1, rect.origin.y, rect.size.w, rect.size.h), overflow, alignment, NULL);
-  graphics_draw_text(ctx, text, font, GRect(rect.origin.x, rect.origin.y - 1, rect.size.w, rect.size.h), overflow, alignment, NULL);
-  graphics_draw_text(ctx, text, font, GRect(rect.origin.x, rect.origin.y + 1, rect.size.w, rect.size.h), overflow, alignment, NULL);
-  // Draw center text
-  graphics_context_set_text_color(ctx, fg_color);
-  graphics_draw_text(ctx, text, font, rect, overflow, alignment, NULL);
+  outline_text_draw(ctx, layer, text, font, rect, overflow, alignment,
+                    fg_color, get_background_color());
 }
 
 // Draw the mesh dot grid pattern within a rect area
-#define MESH_GRID_SIZE 8
-static void draw_mesh_pattern(GContext *ctx, GRect area) {
+static void draw_mesh_pattern(GContext *ctx, Layer *layer, GRect area) {
   if (!s_enable_mesh) return;
-  GColor frame_color = get_text_color();
-  graphics_context_set_stroke_color(ctx, frame_color);
-  graphics_context_set_stroke_width(ctx, 1);
-  for (int y = area.origin.y; y < area.origin.y + area.size.h; y += MESH_GRID_SIZE) {
-    for (int x = area.origin.x; x < area.origin.x + area.size.w; x += MESH_GRID_SIZE) {
-      graphics_draw_line(ctx, GPoint(x, y), GPoint(x, y));
-    }
-  }
+  raster_fill_mesh(ctx, layer, area, get_text_color());
 }
 
-static void draw_forecast_top(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
+// Render the top panel into bounds (layer coordinates)
+static void render_forecast_top(GContext *ctx, Layer *layer, GRect bounds) {
+  const int ox = bounds.origin.x;
+  const int oy = bounds.origin.y;
 
   // Background
   graphics_context_set_fill_color(ctx, get_background_color());
   graphics_fill_rect(ctx, bounds, 0, GCornerNone);
 
   // Draw mesh grid pattern
-  draw_mesh_pattern(ctx, bounds);
+  draw_mesh_pattern(ctx, layer, bounds);
 
   // Draw separator line at the bottom edge
   GColor text_color = get_text_color();
@@ -176,63 +220,54 @@ static void draw_forecast_top(Layer *layer, GContext *ctx) {
   int line_x_start = 0;
   int line_x_end = bounds.size.w;
   if (is_light_theme()) {
-    int max_line_length = (int)(bounds.size.w * 0.8f);
+    int max_line_length = fixed_mul_int(FIXED_FRAC(4, 5), bounds.size.w);
     line_x_start = (bounds.size.w - max_line_length) / 2;
     line_x_end = line_x_start + max_line_length;
   }
-  graphics_draw_line(ctx, GPoint(line_x_start, bounds.size.h - 2), GPoint(line_x_end, bounds.size.h - 2));
+  graphics_draw_line(ctx, GPoint(ox + line_x_start, oy + bounds.size.h - 2), GPoint(ox + line_x_end, oy + bounds.size.h - 2));
 
   // Layout: 3 columns, each with hour label + icon on top + temperature below
   int col_width = bounds.size.w / NUM_FORECAST_SLOTS;
 
-#if defined(PBL_PLATFORM_EMERY)
-  int label_y = 2;
-  int icon_y = 18;
-  int temp_y = icon_y + FORECAST_ICON_SIZE + 1;
-  GFont temp_font = fonts_get_system_font(FONT_KEY_GOTHIC_18);
+  GFont temp_font = fonts_get_system_font(LAYOUT_FORECAST_TEMP_FONT);
   GFont label_font = fonts_get_system_font(FONT_KEY_GOTHIC_14);
-#else
-  int label_y = -4;
-  int icon_y = 14;
-  int temp_y = icon_y + FORECAST_ICON_SIZE;
-  GFont temp_font = fonts_get_system_font(FONT_KEY_GOTHIC_14);
-  GFont label_font = fonts_get_system_font(FONT_KEY_GOTHIC_14);
-#endif
 
   for (int i = 0; i < NUM_FORECAST_SLOTS; i++) {
-    int col_x = i * col_width;
+    int col_x = ox + i * col_width;
     int center_x = col_x + col_width / 2;
 
     // Draw hour label (+3h, +6h, +9h)
-    draw_outlined_text(ctx, s_hour_labels[i], label_font,
-                       GRect(col_x, label_y, col_width, 16),
+    draw_outlined_text(ctx, layer, s_hour_labels[i], label_font,
+                       GRect(col_x, oy + LAYOUT_FORECAST_LABEL_Y, col_width, 16),
                        GTextOverflowModeTrailingEllipsis,
                        GTextAlignmentCenter, text_color);
 
     // Draw forecast icon
     if (s_forecast_icons[i]) {
       GSize icon_size = gdraw_command_image_get_bounds_size(s_forecast_icons[i]);
-      GPoint icon_origin = GPoint(center_x - icon_size.w / 2, icon_y);
-      gdraw_command_image_draw(ctx, s_forecast_icons[i], icon_origin);
+      GPoint icon_origin = GPoint(center_x - icon_size.w / 2, oy + LAYOUT_FORECAST_ICON_Y);
+      icon_cache_draw(ctx, layer, s_forecast_icons[i], s_forecast_icon_resources[i], icon_origin);
     }
 
     // Draw temperature
-    draw_outlined_text(ctx, s_forecast_temp_buffers[i], temp_font,
-                       GRect(col_x, temp_y, col_width, 20),
+    draw_outlined_text(ctx, layer, s_forecast_temp_buffers[i], temp_font,
+                       GRect(col_x, oy + LAYOUT_FORECAST_TEMP_Y, col_width, 20),
                        GTextOverflowModeTrailingEllipsis,
                        GTextAlignmentCenter, text_color);
   }
 }
 
-static void draw_forecast_bottom(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
+// Render the bottom panel into bounds (layer coordinates)
+static void render_forecast_bottom(GContext *ctx, Layer *layer, GRect bounds) {
+  const int ox = bounds.origin.x;
+  const int oy = bounds.origin.y;
 
   // Background
   graphics_context_set_fill_color(ctx, get_background_color());
   graphics_fill_rect(ctx, bounds, 0, GCornerNone);
 
   // Draw mesh grid pattern
-  draw_mesh_pattern(ctx, bounds);
+  draw_mesh_pattern(ctx, layer, bounds);
 
   // Draw separator line at the top edge
   GColor text_color = get_text_color();
@@ -241,18 +276,18 @@ static void draw_forecast_bottom(Layer *layer, GContext *ctx) {
   int line_x_start = 0;
   int line_x_end = bounds.size.w;
   if (is_light_theme()) {
-    int max_line_length = (int)(bounds.size.w * 0.8f);
+    int max_line_length = fixed_mul_int(FIXED_FRAC(4, 5), bounds.size.w);
     line_x_start = (bounds.size.w - max_line_length) / 2;
     line_x_end = line_x_start + max_line_length;
   }
-  graphics_draw_line(ctx, GPoint(line_x_start, 1), GPoint(line_x_end, 1));
+  graphics_draw_line(ctx, GPoint(ox + line_x_start, oy + 1), GPoint(ox + line_x_end, oy + 1));
 
   if (!s_hourly_data_available) {
     graphics_context_set_text_color(ctx, text_color);
     GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_14);
     graphics_draw_text(ctx, "No forecast data",
                        font,
-                       GRect(4, bounds.size.h / 2 - 10, bounds.size.w - 8, 20),
+                       GRect(ox + 4, oy + bounds.size.h / 2 - 10, bounds.size.w - 8, 20),
                        GTextOverflowModeTrailingEllipsis,
                        GTextAlignmentCenter, NULL);
     return;
@@ -263,9 +298,9 @@ static void draw_forecast_bottom(Layer *layer, GContext *ctx) {
   const int margin_right = 4;
   const int margin_top = 8;
   const int margin_bottom = 2;
-  const int graph_x = margin_left;
+  const int graph_x = ox + margin_left;
   const int graph_w = bounds.size.w - margin_left - margin_right;
-  const int graph_y = margin_top;
+  const int graph_y = oy + margin_top;
   const int graph_h = bounds.size.h - margin_top - margin_bottom;
 
   // Find temp min/max for scaling
@@ -282,11 +317,8 @@ static void draw_forecast_bottom(Layer *layer, GContext *ctx) {
   int graph_offset = (graph_w - col_w * NUM_HOURLY_POINTS) / 2;
   const int gx = graph_x + graph_offset;
 
-  // Get current hour for positioning markers
-  time_t now = time(NULL);
-  struct tm *now_tm = localtime(&now);
-  int current_hour = now_tm->tm_hour;
-
+  // Current hour for positioning markers
+  const int current_hour = s_current_hour;
 
   // Draw precipitation bars (filled from bottom, height = precip% of graph_h)
   for (int i = 0; i < NUM_HOURLY_POINTS; i++) {
@@ -330,34 +362,67 @@ static void draw_forecast_bottom(Layer *layer, GContext *ctx) {
   snprintf(max_buf, sizeof(max_buf), "%d°", temp_max);
 
   // Max at top-right
-  draw_outlined_text(ctx, max_buf, label_font,
-                     GRect(bounds.size.w - 30, graph_y - 2, 28, 16),
+  draw_outlined_text(ctx, layer, max_buf, label_font,
+                     GRect(ox + bounds.size.w - 30, graph_y - 2, 28, 16),
                      GTextOverflowModeTrailingEllipsis,
                      GTextAlignmentRight, text_color);
   // Min at bottom-right
-  draw_outlined_text(ctx, min_buf, label_font,
-                     GRect(bounds.size.w - 30, graph_y + graph_h - 14, 28, 16),
+  draw_outlined_text(ctx, layer, min_buf, label_font,
+                     GRect(ox + bounds.size.w - 30, graph_y + graph_h - 14, 28, 16),
                      GTextOverflowModeTrailingEllipsis,
                      GTextAlignmentRight, text_color);
 
   // Draw precipitation scale labels on left y-axis (0% to 100%)
   // 100% at top-left
-  draw_outlined_text(ctx, "100%", label_font,
-                     GRect(2, graph_y - 2, 32, 16),
+  draw_outlined_text(ctx, layer, "100%", label_font,
+                     GRect(ox + 2, graph_y - 2, 32, 16),
                      GTextOverflowModeTrailingEllipsis,
                      GTextAlignmentLeft, text_color);
   // 0% at bottom-left
-  draw_outlined_text(ctx, "0%", label_font,
-                     GRect(2, graph_y + graph_h - 14, 32, 16),
+  draw_outlined_text(ctx, layer, "0%", label_font,
+                     GRect(ox + 2, graph_y + graph_h - 14, 32, 16),
                      GTextOverflowModeTrailingEllipsis,
                      GTextAlignmentLeft, text_color);
 }
 
+// Everything the panels depend on, a different key re-renders them
+static uint32_t panel_cache_key(bool bottom) {
+  return ((uint32_t)s_data_version << 8) |
+         ((bottom ? s_current_hour : 0) << 3) |
+         (is_light_theme() ? 1 : 0) |
+         (s_enable_mesh ? 2 : 0);
+}
+
+// Blit the pre-rendered panel, render it (and keep it if fully on screen)
+// only if the data changed since
+static void draw_forecast_top(Layer *layer, GContext *ctx) {
+  GRect bounds = layer_get_bounds(layer);
+  const uint32_t key = panel_cache_key(false);
+  if (bitmap_cache_draw(&s_top_cache, ctx, bounds, key)) {
+    return;
+  }
+  render_forecast_top(ctx, layer, bounds);
+  bitmap_cache_store(&s_top_cache, ctx, layer_convert_rect_to_screen(layer, bounds), key);
+}
+
+static void draw_forecast_bottom(Layer *layer, GContext *ctx) {
+  GRect bounds = layer_get_bounds(layer);
+  const uint32_t key = panel_cache_key(true);
+  if (bitmap_cache_draw(&s_bottom_cache, ctx, bounds, key)) {
+    return;
+  }
+  render_forecast_bottom(ctx, layer, bounds);
+  bitmap_cache_store(&s_bottom_cache, ctx, layer_convert_rect_to_screen(layer, bounds), key);
+}
+
 static void hide_timer_callback(void *data);
 static void save_forecast_visible(bool visible);
 
+static void cancel_slide();
+
 // Helper to cancel running animations
 static void cancel_animations() {
+  cancel_slide();
   if (s_top_anim) {
     animation_unschedule((Animation *)s_top_anim);
     property_animation_destroy(s_top_anim);
@@ -386,10 +451,60 @@ static GRect bottom_visible_frame() {
   return GRect(0, bottom_y, s_screen_bounds.size.w, WEATHER_FORECAST_BAR_HEIGHT);
 }
 
+static bool rect_contains(GRect outer, GRect inner) {
+  return inner.origin.x >= outer.origin.x &&
+         inner.origin.y >= outer.origin.y &&
+         inner.origin.x + inner.size.w <= outer.origin.x + outer.size.w &&
+         inner.origin.y + inner.size.h <= outer.origin.y + outer.size.h;
+}
+
+// Panels shown and not moving, only then anything is covered
+static bool panels_settled() {
+  return s_is_visible && !s_is_animating;
+}
+
+bool weather_forecast_covers(GRect screen_rect) {
+  return panels_settled() && (rect_contains(top_visible_frame(), screen_rect) ||
+                              rect_contains(bottom_visible_frame(), screen_rect));
+}
+
+// Visibility pass: hide the registered layers the panels cover, show
+// them again as soon as the panels start moving
+static void update_occlusion() {
+  const bool settled = panels_settled();
+  if (s_occluding && !settled) {
+    // The scene under the panels was not kept up to date
+    compositor_mark_dirty(s_scene_layer, top_visible_frame());
+    compositor_mark_dirty(s_scene_layer, bottom_visible_frame());
+  }
+  s_occluding = settled;
+  if (s_is_animating != s_holding_scene) {
+    // Moving panels leave their old pixels behind in the framebuffer
+    s_holding_scene = s_is_animating;
+    compositor_hold_all_dirty(s_is_animating);
+  }
+  const bool up = s_is_visible || s_is_animating;
+  if (up != s_overlay_up) {
+    s_overlay_up = up;
+    if (s_overlay_handler) {
+      s_overlay_handler(up);
+    }
+  }
+  for (int i = 0; i < s_num_occluded_layers; i++) {
+    Layer *layer = s_occluded_layers[i];
+    bool covered = weather_forecast_covers(
+        layer_convert_rect_to_screen(layer, layer_get_bounds(layer)));
+    if (layer_get_hidden(layer) != covered) {
+      layer_set_hidden(layer, covered);
+    }
+  }
+}
+
 static void anim_show_stopped(Animation *animation, bool finished, void *context) {
   s_is_animating = false;
   s_top_anim = NULL;
   s_bottom_anim = NULL;
+  update_occlusion();
   // Schedule auto-hide after display duration (unless "forever")
   int display_ms = forecast_display_ms();
   if (display_ms > 0) {
@@ -402,11 +517,187 @@ static void anim_hide_stopped(Animation *animation, bool finished, void *context
   s_is_visible = false;
   s_top_anim = NULL;
   s_bottom_anim = NULL;
+  update_occlusion();
+}
+
+// Panel frame at the current slide progress
+static GRect slide_frame(GRect from, GRect to) {
+  GRect frame = from;
+  frame.origin.y = from.origin.y +
+      (to.origin.y - from.origin.y) * (int32_t)s_slide_progress / ANIMATION_NORMALIZED_MAX;
+  return frame;
+}
+
+static GRect slide_top_frame() {
+  return s_slide_show ? slide_frame(top_hidden_frame(), top_visible_frame())
+                      : slide_frame(top_visible_frame(), top_hidden_frame());
+}
+
+static GRect slide_bottom_frame() {
+  return s_slide_show ? slide_frame(bottom_hidden_frame(), bottom_visible_frame())
+                      : slide_frame(bottom_visible_frame(), bottom_hidden_frame());
+}
+
+static void destroy_scene_snapshots() {
+  if (s_scene_top) {
+    gbitmap_destroy(s_scene_top);
+    s_scene_top = NULL;
+  }
+  if (s_scene_bottom) {
+    gbitmap_destroy(s_scene_bottom);
+    s_scene_bottom = NULL;
+  }
+}
+
+static GBitmap *snapshot_scene(GBitmap *fb, GRect screen_rect) {
+  GBitmap *bitmap = bitmap_cache_create_bitmap(screen_rect.size, gbitmap_get_format(fb));
+  if (bitmap && !bitmap_cache_copy_from_framebuffer(fb, screen_rect, bitmap)) {
+    gbitmap_destroy(bitmap);
+    bitmap = NULL;
+  }
+  return bitmap;
+}
+
+// Keep the scene under the shown panels. Returns false if it could not be
+// copied, the scene then stays visible and is redrawn below the panels.
+static bool capture_scene(GContext *ctx) {
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) {
+    return false;
+  }
+  s_scene_top = snapshot_scene(fb, top_visible_frame());
+  s_scene_bottom = snapshot_scene(fb, bottom_visible_frame());
+  graphics_release_frame_buffer(ctx, fb);
+  if (!s_scene_top || !s_scene_bottom) {
+    destroy_scene_snapshots();
+    return false;
+  }
+  return true;
+}
+
+// Blit the rows y0..y1 (screen) of a scene snapshot taken at area
+static void restore_scene_rows(GContext *ctx, GBitmap *scene, GRect area, int y0, int y1) {
+  if (y0 < area.origin.y) y0 = area.origin.y;
+  if (y1 > area.origin.y + area.size.h) y1 = area.origin.y + area.size.h;
+  if (y1 <= y0) {
+    return;
+  }
+  GRect rows = GRect(0, y0 - area.origin.y, area.size.w, y1 - y0);
+  gbitmap_set_bounds(scene, rows);
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+  graphics_draw_bitmap_in_rect(ctx, scene, GRect(area.origin.x, y0, rows.size.w, rows.size.h));
+  gbitmap_set_bounds(scene, GRect(0, 0, area.size.w, area.size.h));
+}
+
+static void draw_slide(Layer *layer, GContext *ctx) {
+  const GRect top = slide_top_frame();
+  const GRect bottom = slide_bottom_frame();
+
+  if (!s_slide_drawn) {
+    // First frame: the scene was just drawn below without the panels.
+    // Showing panels only ever cover more of it, hiding needs it back.
+    s_slide_retained = s_slide_show || capture_scene(ctx);
+    s_slide_drawn = true;
+  } else if (s_slide_retained && !s_slide_show) {
+    // Only the rows uncovered since the last frame change
+    restore_scene_rows(ctx, s_scene_top, top_visible_frame(),
+                       top.origin.y + top.size.h,
+                       s_slide_prev_top.origin.y + s_slide_prev_top.size.h);
+    restore_scene_rows(ctx, s_scene_bottom, bottom_visible_frame(),
+                       s_slide_prev_bottom.origin.y, bottom.origin.y);
+  }
+
+  bitmap_cache_draw(&s_top_cache, ctx, top, panel_cache_key(false));
+  bitmap_cache_draw(&s_bottom_cache, ctx, bottom, panel_cache_key(true));
+  s_slide_prev_top = top;
+  s_slide_prev_bottom = bottom;
+}
+
+// Hide the scene once its pixels are in the framebuffer (or the snapshots),
+// so that further frames only run the slide layer. The window background
+// is clear, the framebuffer keeps them.
+static void retain_scene(bool retain) {
+  layer_set_hidden(s_scene_layer, retain);
+}
+
+static void slide_update(Animation *animation, const AnimationProgress progress) {
+  if (s_slide_drawn && s_slide_retained && !layer_get_hidden(s_scene_layer)) {
+    retain_scene(true);
+  }
+  s_slide_progress = progress;
+  layer_mark_dirty(s_slide_layer);
+}
+
+static const AnimationImplementation s_slide_implementation = {
+  .update = slide_update
+};
+
+static void slide_stopped(Animation *animation, bool finished, void *context) {
+  s_slide_anim = NULL;
+  destroy_scene_snapshots();
+  retain_scene(false);
+  layer_set_hidden(s_slide_layer, true);
+
+  layer_set_frame(s_forecast_top_layer, s_slide_show ? top_visible_frame() : top_hidden_frame());
+  layer_set_frame(s_forecast_bottom_layer, s_slide_show ? bottom_visible_frame() : bottom_hidden_frame());
+  layer_set_hidden(s_forecast_top_layer, false);
+  layer_set_hidden(s_forecast_bottom_layer, false);
+
+  if (s_slide_show) {
+    anim_show_stopped(animation, finished, context);
+  } else {
+    anim_hide_stopped(animation, finished, context);
+  }
+}
+
+static void cancel_slide() {
+  if (s_slide_anim) {
+    // Runs slide_stopped, which restores the layers
+    animation_unschedule(s_slide_anim);
+  }
+}
+
+// Slide the pre-rendered panels over the framebuffer. Returns false if
+// the panels are not rendered for the current data yet.
+static bool framebuffer_slide(bool show) {
+  if (!s_top_cache.valid || s_top_cache.key != panel_cache_key(false) ||
+      !s_bottom_cache.valid || s_bottom_cache.key != panel_cache_key(true)) {
+    return false;
+  }
+
+  s_slide_anim = animation_create();
+  if (!s_slide_anim) {
+    return false;
+  }
+  animation_set_implementation(s_slide_anim, &s_slide_implementation);
+  animation_set_duration(s_slide_anim, WEATHER_FORECAST_ANIM_DURATION_MS);
+  animation_set_curve(s_slide_anim, AnimationCurveEaseInOut);
+  animation_set_handlers(s_slide_anim, (AnimationHandlers) {
+    .stopped = slide_stopped
+  }, NULL);
+
+  s_slide_show = show;
+  s_slide_progress = 0;
+  s_slide_drawn = false;
+  s_slide_retained = false;
+  layer_set_hidden(s_forecast_top_layer, true);
+  layer_set_hidden(s_forecast_bottom_layer, true);
+  layer_set_hidden(s_slide_layer, false);
+
+  s_is_animating = true;
+  update_occlusion();
+  animation_schedule(s_slide_anim);
+  return true;
 }
 
 static void animate_slide(bool show) {
   cancel_animations();
 
+  if (framebuffer_slide(show)) {
+    return;
+  }
+
+  // Fallback: move the layers, redrawing the whole scene every frame
   GRect top_from = show ? top_hidden_frame() : top_visible_frame();
   GRect top_to = show ? top_visible_frame() : top_hidden_frame();
   GRect bot_from = show ? bottom_hidden_frame() : bottom_visible_frame();
@@ -427,6 +718,7 @@ static void animate_slide(bool show) {
   animation_set_handlers((Animation *)s_top_anim, handlers, NULL);
 
   s_is_animating = true;
+  update_occlusion();
   animation_schedule((Animation *)s_top_anim);
   animation_schedule((Animation *)s_bottom_anim);
 }
@@ -437,8 +729,12 @@ static void hide_timer_callback(void *data) {
   save_forecast_visible(false);
 }
 
-void weather_forecast_init(Layer *window_layer, GRect bounds) {
+void weather_forecast_init(Layer *window_layer, Layer *scene_layer, GRect bounds) {
   s_screen_bounds = bounds;
+  s_scene_layer = scene_layer;
+
+  time_t now = time(NULL);
+  s_current_hour = localtime(&now)->tm_hour;
 
   // Top bar: start off-screen above
   s_forecast_top_layer = layer_create(top_hidden_frame());
@@ -450,15 +746,25 @@ void weather_forecast_init(Layer *window_layer, GRect bounds) {
   layer_set_update_proc(s_forecast_bottom_layer, draw_forecast_bottom);
   layer_add_child(window_layer, s_forecast_bottom_layer);
 
+  // Slide layer above everything, only shown while sliding
+  s_slide_layer = layer_create(bounds);
+  layer_set_update_proc(s_slide_layer, draw_slide);
+  layer_set_hidden(s_slide_layer, true);
+  layer_add_child(window_layer, s_slide_layer);
+
   weather_forecast_load_data();
 
   // Restore previous visible state (not if disabled)
-  if (s_weather_forecast_flick_mode != 0 && persist_exists(PERSIST_KEY_WEATHER_FORECAST_VISIBLE)
-      && persist_read_bool(PERSIST_KEY_WEATHER_FORECAST_VISIBLE)) {
+  const bool visible_stored = persist_exists(PERSIST_KEY_WEATHER_FORECAST_VISIBLE);
+  s_saved_visible = visible_stored && read_flag(PERSIST_KEY_WEATHER_FORECAST_VISIBLE);
+  journal_register_data(PERSIST_KEY_WEATHER_FORECAST_VISIBLE, &s_saved_visible,
+                        sizeof(s_saved_visible), visible_stored);
+  if (s_weather_forecast_flick_mode != 0 && s_saved_visible) {
     // Show immediately without animation
     layer_set_frame(s_forecast_top_layer, top_visible_frame());
     layer_set_frame(s_forecast_bottom_layer, bottom_visible_frame());
     s_is_visible = true;
+    update_occlusion();
 
     // Schedule auto-hide if not "forever"
     int display_ms = forecast_display_ms();
@@ -468,12 +774,39 @@ void weather_forecast_init(Layer *window_layer, GRect bounds) {
   }
 }
 
+void weather_forecast_set_overlay_handler(WeatherForecastOverlayHandler handler) {
+  s_overlay_handler = handler;
+}
+
+void weather_forecast_add_occluded_layer(Layer *layer) {
+  if (s_num_occluded_layers < WEATHER_FORECAST_MAX_OCCLUDED) {
+    s_occluded_layers[s_num_occluded_layers++] = layer;
+    update_occlusion();
+  }
+}
+
+GRect weather_forecast_uncovered_rect() {
+  if (!panels_settled()) {
+    return s_screen_bounds;
+  }
+  const GRect top = top_visible_frame();
+  const GRect bottom = bottom_visible_frame();
+  const int y = top.origin.y + top.size.h;
+  return GRect(0, y, s_screen_bounds.size.w, bottom.origin.y - y);
+}
+
 void weather_forecast_deinit() {
   cancel_animations();
+  bitmap_cache_destroy(&s_top_cache);
+  bitmap_cache_destroy(&s_bottom_cache);
   if (s_hide_timer) {
     app_timer_cancel(s_hide_timer);
     s_hide_timer = NULL;
   }
+  if (s_prerender_timer) {
+    app_timer_cancel(s_prerender_timer);
+    s_prerender_timer = NULL;
+  }
   if (s_forecast_top_layer) {
     layer_destroy(s_forecast_top_layer);
     s_forecast_top_layer = NULL;
@@ -482,16 +815,19 @@ void weather_forecast_deinit() {
     layer_destroy(s_forecast_bottom_layer);
     s_forecast_bottom_layer = NULL;
   }
-  for (int i = 0; i < NUM_FORECAST_SLOTS; i++) {
-    if (s_forecast_icons[i]) {
-      gdraw_command_image_destroy(s_forecast_icons[i]);
-      s_forecast_icons[i] = NULL;
-    }
+  if (s_slide_layer) {
+    layer_destroy(s_slide_layer);
+    s_slide_layer = NULL;
   }
+  s_num_occluded_layers = 0;
+  s_occluding = false;
+  // The icons live in the window arena, released with the main window
 }
 
+// Written behind, and not at all if it ends up as stored
 static void save_forecast_visible(bool visible) {
-  persist_write_bool(PERSIST_KEY_WEATHER_FORECAST_VISIBLE, visible);
+  s_saved_visible = visible;
+  journal_mark(PERSIST_KEY_WEATHER_FORECAST_VISIBLE);
 }
 
 void weather_forecast_show() {
@@ -515,8 +851,65 @@ void weather_forecast_show() {
   s_is_visible = true;
   animate_slide(true);
   save_forecast_visible(true);
+  memstats_record(MEMSTATS_FORECAST);
 }
 
 bool weather_forecast_is_visible() {
   return s_is_visible;
 }
+
+void weather_forecast_set_hour(int hour) {
+  s_current_hour = hour;
+}
+
+// A panel was stale but only partly redrawn: redraw it whole next frame.
+// Marked after the current frame, the dirty rect must not change while
+// the layers draw.
+static void prerender_timer_callback(void *data) {
+  s_prerender_timer = NULL;
+  compositor_mark_dirty(s_scene_layer, top_visible_frame());
+  compositor_mark_dirty(s_scene_layer, bottom_visible_frame());
+}
+
+// True if the whole of rect (layer coordinates) is redrawn this frame
+static bool is_redrawn(Layer *layer, GRect rect) {
+  return rect_contains(compositor_clip(), layer_convert_rect_to_screen(layer, rect));
+}
+
+void weather_forecast_prerender(GContext *ctx, Layer *layer) {
+  // Nothing to prepare if the panels can not be shown
+  if (s_weather_forecast_flick_mode == 0) {
+    return;
+  }
+
+  const uint32_t top_key = panel_cache_key(false);
+  const uint32_t bottom_key = panel_cache_key(true);
+  const bool top_stale = !s_top_cache.valid || s_top_cache.key != top_key;
+  const bool bottom_stale = !s_bottom_cache.valid || s_bottom_cache.key != bottom_key;
+  if (!top_stale && !bottom_stale) {
+    return;
+  }
+
+  // Render where the panels are when shown, keep the pixels and clear the
+  // area again for the layers drawn afterwards
+  const GRect top = top_visible_frame();
+  const GRect bottom = bottom_visible_frame();
+  if ((top_stale && !is_redrawn(layer, top)) || (bottom_stale && !is_redrawn(layer, bottom))) {
+    if (!s_prerender_timer) {
+      s_prerender_timer = app_timer_register(0, prerender_timer_callback, NULL);
+    }
+    return;
+  }
+  if (top_stale) {
+    render_forecast_top(ctx, layer, top);
+    bitmap_cache_store(&s_top_cache, ctx, layer_convert_rect_to_screen(layer, top), top_key);
+  }
+  if (bottom_stale) {
+    render_forecast_bottom(ctx, layer, bottom);
+    bitmap_cache_store(&s_bottom_cache, ctx, layer_convert_rect_to_screen(layer, bottom), bottom_key);
+  }
+  graphics_context_set_fill_color(ctx, get_background_color());
+  if (top_stale) graphics_fill_rect(ctx, top, 0, GCornerNone);
+  if (bottom_stale) graphics_fill_rect(ctx, bottom, 0, GCornerNone);
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Pre-rendered forecast panels");
+}
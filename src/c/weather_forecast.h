@@ -3,16 +3,16 @@
 #define WEATHER_FORECAST_H
 
 #include <pebble.h>
+#include "generated/layout.h"
 
 // Weather detail bar height extends from top of screen to the upper horizontal line
-#if defined(PBL_PLATFORM_EMERY)
-  #define WEATHER_FORECAST_BAR_HEIGHT 77  // bounds.size.h/2 - 38 on emery (228/2 - 38 = 76)
-#else
-  #define WEATHER_FORECAST_BAR_HEIGHT 55  // bounds.size.h/2 - 30 on standard (168/2 - 30 = 54)
-#endif
+#define WEATHER_FORECAST_BAR_HEIGHT LAYOUT_FORECAST_BAR_HEIGHT
 
 #define WEATHER_FORECAST_ANIM_DURATION_MS 1000
 
+// Layers that can be registered to be hidden while the panels cover them
+#define WEATHER_FORECAST_MAX_OCCLUDED 8
+
 #define NUM_FORECAST_SLOTS 3
 #define NUM_HOURLY_POINTS 24
 
@@ -29,8 +29,25 @@ extern int s_hourly_temps[NUM_HOURLY_POINTS];
 extern int s_hourly_precip[NUM_HOURLY_POINTS];
 extern bool s_hourly_data_available;
 
-// Initialize the weather detail layers and add them to the window
-void weather_forecast_init(Layer *window_layer, GRect bounds);
+// Initialize the weather detail layers and add them to the window.
+// scene_layer holds everything below the panels, it is hidden while the
+// panels slide over the retained framebuffer.
+void weather_forecast_init(Layer *window_layer, Layer *scene_layer, GRect bounds);
+
+// Called with true when the panels start to show, with false once they are
+// completely hidden again
+typedef void (*WeatherForecastOverlayHandler)(bool up);
+void weather_forecast_set_overlay_handler(WeatherForecastOverlayHandler handler);
+
+// Hide layer whenever the shown panels cover it completely
+void weather_forecast_add_occluded_layer(Layer *layer);
+
+// screen_rect lies completely below the shown panels
+bool weather_forecast_covers(GRect screen_rect);
+
+// Screen area not covered by the panels. The whole screen while they are
+// hidden or moving.
+GRect weather_forecast_uncovered_rect();
 
 // Destroy the weather detail layers
 void weather_forecast_deinit();
@@ -48,6 +65,14 @@ void weather_forecast_update_icons();
 void weather_forecast_parse_hourly_temps(const char *csv);
 void weather_forecast_parse_hourly_precip(const char *csv);
 
+// Current hour for the "now" marker of the graph, re-renders the panel
+void weather_forecast_set_hour(int hour);
+
+// Render the panels into their caches if the data changed since they were
+// last rendered. Called at the start of the frame layer update proc (a
+// full screen layer at 0,0), before anything else is drawn there.
+void weather_forecast_prerender(GContext *ctx, Layer *layer);
+
 // Storage
 void weather_forecast_save_data();
 void weather_forecast_load_data();
@@ -0,0 +1,74 @@
+#include "widget.h"
+#include "weather.h"
+#include "steps.h"
+#include "battery.h"
+#include "calendar.h"
+#include "disconnect.h"
+#include "heart_rate.h"
+#include "colored_box.h"
+
+// Registered widgets by info type. New info types only need an entry here.
+static const Widget* const s_widgets[] = {
+  [INFO_TYPE_WEATHER] = &weather_widget,
+  [INFO_TYPE_TEMPERATURE] = &temperature_widget,
+  [INFO_TYPE_STEPS] = &steps_widget,
+  [INFO_TYPE_BATTERY] = &battery_widget,
+  [INFO_TYPE_COLORED_BOX] = &colored_box_widget,
+  [INFO_TYPE_NONE] = NULL,
+  [INFO_TYPE_CALENDAR] = &calendar_widget,
+  [INFO_TYPE_DISCONNECT] = &disconnect_widget,
+  [INFO_TYPE_HEART_RATE] = &heart_rate_widget
+};
+
+// Draw list entries of the bound slots, handed out in slot order
+static DrawOp s_arena[NUM_INFO_LAYERS * WIDGET_MAX_OPS];
+
+const Widget* widget_for_type(InfoType info_type) {
+  if ((unsigned)info_type >= ARRAY_LENGTH(s_widgets)) {
+    return NULL;
+  }
+  return s_widgets[info_type];
+}
+
+bool widget_bind_slots(InfoLayer* slots, const InfoType* types, int count) {
+  bool changed = false;
+  for (int i = 0; i < count; i++) {
+    if (slots[i].type != types[i] || slots[i].widget != widget_for_type(types[i])) {
+      changed = true;
+    }
+  }
+  if (!changed) {
+    return false;
+  }
+
+  int used = 0;
+  for (int i = 0; i < count; i++) {
+    const Widget* widget = widget_for_type(types[i]);
+    int ops = widget ? widget->max_ops : 0;
+    if (used + ops > (int)ARRAY_LENGTH(s_arena)) {
+      APP_LOG(APP_LOG_LEVEL_WARNING, "Widget arena full, slot %d left empty", i);
+      ops = 0;
+    }
+    slots[i].type = types[i];
+    slots[i].widget = widget;
+    draw_list_init(&slots[i].draw_list, &s_arena[used], ops);
+    used += ops;
+  }
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Widgets bound, %d of %d draw entries used",
+          used, (int)ARRAY_LENGTH(s_arena));
+  return true;
+}
+
+bool widget_update_slot(InfoLayer* slot) {
+  // The entries before the update, to tell whether the slot draws differently
+  DrawOp previous_ops[WIDGET_MAX_OPS];
+  DrawList previous;
+  draw_list_init(&previous, previous_ops, WIDGET_MAX_OPS);
+  draw_list_copy(&previous, &slot->draw_list);
+
+  draw_list_clear(&slot->draw_list);
+  if (slot->widget) {
+    slot->widget->update(slot);
+  }
+  return !draw_list_equal(&slot->draw_list, &previous);
+}
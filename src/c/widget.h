@@ -0,0 +1,40 @@
+#ifndef WIDGET_H
+#define WIDGET_H
+
+#include <pebble.h>
+#include "config.h"
+#include "store.h"
+
+/*
+ * Definitions
+ */
+
+// Most draw list entries a widget adds (battery and steps: background,
+// level, text, icon)
+#define WIDGET_MAX_OPS 4
+
+// One info type. update fills the (cleared) draw list of a slot showing it
+// from the current data, max_ops sizes that list. reads holds the
+// STORE_BITs of the store fields the content depends on, slots are only
+// refreshed when one of them changed.
+struct Widget {
+  uint8_t max_ops;
+  uint32_t reads;
+  void (*update)(InfoLayer* info_layer);
+};
+
+/*
+ * Function Declarations
+ */
+
+// Widget registered for info_type, NULL for INFO_TYPE_NONE
+const Widget* widget_for_type(InfoType info_type);
+
+// Bind the slots to the widgets of types. If any slot changes its type, all
+// of them get new draw lists from the widget arena and true is returned.
+bool widget_bind_slots(InfoLayer* slots, const InfoType* types, int count);
+
+// Rebuild the draw list of a slot, true if it draws differently now
+bool widget_update_slot(InfoLayer* slot);
+
+#endif // WIDGET_H
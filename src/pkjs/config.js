@@ -51,6 +51,13 @@ module.exports = [
         "description": "Vibrate 3 times when the watch connects or disconnects from the phone.",
         "defaultValue": false
       },
+      {
+        "type": "toggle",
+        "messageKey": "SHOW_SECONDS",
+        "label": "Show Seconds",
+        "description": "A small tick moves along the upper line every second. Paused while the weather screen is shown. Uses more battery.",
+        "defaultValue": false
+      },
       {
         "type": "toggle",
         "messageKey": "ENABLE_MESH",
@@ -258,6 +265,22 @@ module.exports = [
       }
     ]
   },
+  {
+    "type": "section",
+    "items": [
+      {
+        "type": "heading",
+        "defaultValue": "Debug"
+      },
+      {
+        "type": "toggle",
+        "messageKey": "MEMORY_REPORT",
+        "label": "Memory Report",
+        "description": "Ask the watch for its heap and stack use on start and after saving. The report shows up in the phone logs.",
+        "defaultValue": false
+      }
+    ]
+  },
   {
     "type": "submit",
     "defaultValue": "Save Settings"
@@ -20,7 +20,9 @@ var config = {
   dateFormat: ' %a %d', // strftime format pattern for date display
   lightShowBackground: true, // Show gray box in light theme
   darkShowBorder: true, // Show border in dark theme
-  vibrateOnDisconnect: false // Vibrate on connect/disconnect
+  vibrateOnDisconnect: false, // Vibrate on connect/disconnect
+  showSeconds: false, // Seconds tick on the upper line
+  memoryReport: false // Debug: ask the watch for its memory report
 };
 
 // Load saved configuration
@@ -75,6 +77,12 @@ if (localStorage.getItem('DARK_SHOW_BORDER') !== null) {
 if (localStorage.getItem('VIBRATE_ON_DISCONNECT') !== null) {
   config.vibrateOnDisconnect = (localStorage.getItem('VIBRATE_ON_DISCONNECT') === 'true');
 }
+if (localStorage.getItem('SHOW_SECONDS') !== null) {
+  config.showSeconds = (localStorage.getItem('SHOW_SECONDS') === 'true');
+}
+if (localStorage.getItem('MEMORY_REPORT') !== null) {
+  config.memoryReport = (localStorage.getItem('MEMORY_REPORT') === 'true');
+}
 
 // Variables to store weather data
 var weatherData = {
@@ -462,6 +470,13 @@ function enqueueMessage(label, message) {
   }
 }
 
+// Debug: ask the watch for its memory report, logged by the appmessage handler
+function requestMemoryReport() {
+  if (config.memoryReport) {
+    enqueueMessage('memstats', { 'MEMSTATS': 1 });
+  }
+}
+
 // Function to send data to Pebble in smaller chunks
 function sendDataToPebble() {
   console.log('Queueing data for pebble.');
@@ -483,7 +498,8 @@ function sendDataToPebble() {
     'DATE_FORMAT': config.dateFormat,
     'LIGHT_SHOW_BACKGROUND': config.lightShowBackground ? 1 : 0,
     'DARK_SHOW_BORDER': config.darkShowBorder ? 1 : 0,
-    'VIBRATE_ON_DISCONNECT': config.vibrateOnDisconnect ? 1 : 0
+    'VIBRATE_ON_DISCONNECT': config.vibrateOnDisconnect ? 1 : 0,
+    'SHOW_SECONDS': config.showSeconds ? 1 : 0
   });
 
   // Message 2: Weather data + forecast
@@ -519,6 +535,11 @@ Pebble.addEventListener('appmessage', function(e) {
     fetchWeatherForLocation();
   }
   
+  // Memory report, answer to a MEMSTATS debug request
+  if (e.payload.MEMSTATS) {
+    console.log(e.payload.MEMSTATS);
+  }
+
   // Check if it's a location configuration update
   if (e.payload.WEATHER_LOCATION_CONFIG) {
     config.location = e.payload.WEATHER_LOCATION_CONFIG;
@@ -610,6 +631,19 @@ Pebble.addEventListener('webviewclosed', function(e) {
     layoutChanged = true;
   }
 
+  if (dict.SHOW_SECONDS !== undefined) {
+    config.showSeconds = dict.SHOW_SECONDS.value;
+    localStorage.setItem('SHOW_SECONDS', config.showSeconds);
+    console.log('Show seconds saved to: ' + config.showSeconds);
+    layoutChanged = true;
+  }
+
+  if (dict.MEMORY_REPORT !== undefined) {
+    config.memoryReport = dict.MEMORY_REPORT.value;
+    localStorage.setItem('MEMORY_REPORT', config.memoryReport);
+    console.log('Memory report saved to: ' + config.memoryReport);
+  }
+
   if (dict.DATE_FORMAT !== undefined) {
     config.dateFormat = dict.DATE_FORMAT.value || ' %a %d';
     localStorage.setItem('DATE_FORMAT', config.dateFormat);
@@ -655,6 +689,7 @@ Pebble.addEventListener('webviewclosed', function(e) {
     console.log('Layout saved: ' + config.layoutUpperLeft + ',' + config.layoutUpperRight + ',' + config.layoutLowerLeft + ',' + config.layoutLowerRight);
     sendDataToPebble();
   }
+  requestMemoryReport();
 
 });
 
@@ -670,6 +705,7 @@ Pebble.addEventListener('ready', function() {
   console.log('PebbleKit JS ready!');
   console.log('Initial weather fetch for location: "' + config.location + '" (empty = GPS)');
   //fetchWeatherForLocation();
+  requestMemoryReport();
 });
 
 
@@ -0,0 +1,23 @@
+// Host stand-in for the SDK header: just what the plain C modules under
+// test (arena, pdc) use
+#ifndef PEBBLE_H
+#define PEBBLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define APP_LOG_LEVEL_ERROR "E"
+#define APP_LOG_LEVEL_WARNING "W"
+#define APP_LOG_LEVEL_INFO "I"
+#define APP_LOG_LEVEL_DEBUG "D"
+// Debug messages are dropped
+#define APP_LOG(level, ...) \
+  ((level)[0] == 'D' ? 0 : (fprintf(stderr, "[%s] ", level), fprintf(stderr, __VA_ARGS__), \
+                            fputc('\n', stderr)))
+
+#define ARRAY_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+#endif // PEBBLE_H
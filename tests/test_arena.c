@@ -0,0 +1,147 @@
+// Soak test of the icon arena: loads the PDC icon resources into arena
+// blocks over and over, the way load_pdc_icon does on weather changes, and
+// resets the arena the way the main window unload does.
+#include <pebble.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include "arena.h"
+#include "pdc.h"
+
+#define MAX_ICONS 64
+#define NUM_SLOTS 9
+#define ROUNDS 100000
+#define ROUNDS_PER_WINDOW 500
+
+static struct {
+  char name[512];
+  uint8_t data[1024];
+  size_t size;
+} s_icons[MAX_ICONS];
+static int s_num_icons = 0;
+static int s_failures = 0;
+
+#define CHECK(condition, ...) do { \
+    if (!(condition)) { \
+      fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr); \
+      s_failures++; \
+    } \
+  } while (0)
+
+static void read_icons(const char *dir) {
+  DIR *d = opendir(dir);
+  if (!d) {
+    return;
+  }
+  struct dirent *entry;
+  while ((entry = readdir(d)) != NULL) {
+    if (entry->d_name[0] == '.' || strcmp(entry->d_name, "generated") == 0) {
+      continue;
+    }
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+    const size_t length = strlen(entry->d_name);
+    if (length < 4 || strcmp(entry->d_name + length - 4, ".pdc") != 0) {
+      read_icons(path);
+      continue;
+    }
+    if (s_num_icons >= MAX_ICONS) {
+      break;
+    }
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+      continue;
+    }
+    snprintf(s_icons[s_num_icons].name, sizeof(s_icons[0].name), "%s", path);
+    s_icons[s_num_icons].size = fread(s_icons[s_num_icons].data, 1, sizeof(s_icons[0].data), file);
+    fclose(file);
+    s_num_icons++;
+  }
+  closedir(d);
+}
+
+// Every resource is a PDC file whose image fits one arena block
+static void test_resources() {
+  for (int i = 0; i < s_num_icons; i++) {
+    const int size = pdc_image_size(s_icons[i].data, s_icons[i].size);
+    CHECK(size > 0, "%s: not a PDC file", s_icons[i].name);
+    CHECK(size <= ARENA_ICON_SIZE, "%s: %d byte image over ARENA_ICON_SIZE %d",
+          s_icons[i].name, size, ARENA_ICON_SIZE);
+    PdcInfo info;
+    CHECK(size > 0 && pdc_parse(s_icons[i].data + PDC_HEADER_SIZE, size, &info),
+          "%s: invalid PDC image", s_icons[i].name);
+  }
+}
+
+// A corrupt header or command list is refused
+static void test_corrupt() {
+  uint8_t data[1024];
+  memcpy(data, s_icons[0].data, s_icons[0].size);
+  CHECK(pdc_image_size(data, s_icons[0].size - 1) < 0, "truncated file accepted");
+  data[0] = 'X';
+  CHECK(pdc_image_size(data, s_icons[0].size) < 0, "wrong magic accepted");
+  PdcInfo info;
+  CHECK(!pdc_parse(s_icons[0].data + PDC_HEADER_SIZE, s_icons[0].size - PDC_HEADER_SIZE - 1, &info),
+        "truncated image accepted");
+}
+
+// Reload icons into their blocks, reset the arena every window. Blocks of
+// the other slots must keep their icons and the arena must never grow past
+// one block per slot.
+static void test_reload_cycle() {
+  uint8_t *blocks[NUM_SLOTS];
+  int loaded[NUM_SLOTS];
+  unsigned seed = 1;
+  size_t peak = 0;
+  for (int round = 0; round < ROUNDS && s_failures == 0; round++) {
+    if (round % ROUNDS_PER_WINDOW == 0) {
+      arena_reset();
+      CHECK(arena_used() == 0, "arena not empty after reset");
+      memset(blocks, 0, sizeof(blocks));
+    }
+    seed = seed * 1103515245 + 12345;
+    const int slot = (seed >> 16) % NUM_SLOTS;
+    const int icon = (seed >> 8) % s_num_icons;
+
+    if (!blocks[slot]) {
+      blocks[slot] = arena_alloc(ARENA_ICON_SIZE);
+      CHECK(blocks[slot] != NULL, "arena full at round %d", round);
+      if (!blocks[slot]) {
+        break;
+      }
+    }
+    const int size = pdc_image_size(s_icons[icon].data, s_icons[icon].size);
+    memcpy(blocks[slot], s_icons[icon].data + PDC_HEADER_SIZE, size);
+    loaded[slot] = icon;
+
+    for (int i = 0; i < NUM_SLOTS; i++) {
+      if (!blocks[i]) {
+        continue;
+      }
+      const int other = loaded[i];
+      CHECK(memcmp(blocks[i], s_icons[other].data + PDC_HEADER_SIZE,
+                   s_icons[other].size - PDC_HEADER_SIZE) == 0,
+            "slot %d overwritten at round %d", i, round);
+    }
+    if (arena_used() > peak) {
+      peak = arena_used();
+    }
+  }
+  CHECK(peak <= NUM_SLOTS * ARENA_ICON_SIZE, "arena grew to %d bytes", (int)peak);
+  CHECK(arena_peak() == peak, "arena_peak %d, seen %d", (int)arena_peak(), (int)peak);
+}
+
+int main(int argc, char **argv) {
+  read_icons(argc > 1 ? argv[1] : "../resources/images");
+  if (s_num_icons == 0) {
+    fprintf(stderr, "No PDC icons found\n");
+    return 1;
+  }
+  test_resources();
+  test_corrupt();
+  test_reload_cycle();
+  printf("%d icons, %d reload rounds: %s\n", s_num_icons, ROUNDS,
+         s_failures ? "FAILED" : "ok");
+  return s_failures ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""
+Compare the memory reports of the watchface against per-platform budgets.
+
+The app logs one line per session (and answers the MEMSTATS debug message
+with the same line):
+
+    memstats <platform> peak=<used>/<free> <point>=<used>/<free>... <subsystem>=<count>/<bytes>... arena=<used>/<peak> stack=<used>/<painted>
+
+Usage: pebble logs | tools/memstats_report.py
+       tools/memstats_report.py session.log [...]
+
+Exits with 1 if a report is over its platform budget.
+"""
+import fileinput
+import re
+import sys
+
+# Heap budgets: the highest heap use and the lowest free heap allowed. The
+# app's RAM (24 KB on aplite, 64 KB on basalt and diorite, 128 KB on emery)
+# also holds the code, the statics and the AppMessage buffers.
+BUDGETS = {
+    'aplite': {'max_used': 12 * 1024, 'min_free': 2 * 1024},
+    'basalt': {'max_used': 40 * 1024, 'min_free': 4 * 1024},
+    'diorite': {'max_used': 40 * 1024, 'min_free': 4 * 1024},
+    'emery': {'max_used': 80 * 1024, 'min_free': 4 * 1024},
+}
+
+POINTS = ['peak', 'init', 'load', 'rebuild', 'theme', 'forecast']
+SUBSYSTEMS = ['icons', 'bitmaps']
+
+REPORT = re.compile(r'memstats (\w+)((?: \w+=\d+/\d+)+)')
+
+
+def parse(line):
+    match = REPORT.search(line)
+    if not match:
+        return None
+    values = {}
+    for field in match.group(2).split():
+        name, pair = field.split('=')
+        first, second = pair.split('/')
+        values[name] = (int(first), int(second))
+    return match.group(1), values
+
+
+def check(platform, values):
+    """Print the report, return the list of budget violations."""
+    budget = BUDGETS.get(platform)
+    print('{}:'.format(platform))
+    for point in POINTS:
+        if point in values:
+            used, free = values[point]
+            sampled = free > 0 or used > 0
+            print('  {:<9} used {:>6} free {:>6}'.format(point, used, free) if sampled else
+                  '  {:<9} not sampled'.format(point))
+    for subsystem in SUBSYSTEMS:
+        if subsystem in values:
+            count, size = values[subsystem]
+            print('  {:<9} {:>4} allocations, {:>6} bytes'.format(subsystem, count, size))
+    if 'arena' in values:
+        used, peak = values['arena']
+        print('  {:<9} used {:>6} peak {:>6}'.format('arena', used, peak))
+    stack_exhausted = False
+    if 'stack' in values:
+        used, painted = values['stack']
+        # All of the painted range overwritten: the real depth is unknown
+        stack_exhausted = painted > 0 and used >= painted
+        print('  {:<9} used {:>6} of {:>4} painted{}'.format(
+            'stack', used, painted, ' (exhausted)' if stack_exhausted else ''))
+
+    if not budget:
+        return ['{}: no budget'.format(platform)]
+    used, free = values.get('peak', (0, 0))
+    problems = []
+    if used > budget['max_used']:
+        problems.append('{}: peak heap use {} over budget {}'.format(platform, used, budget['max_used']))
+    if free < budget['min_free']:
+        problems.append('{}: free heap {} under budget {}'.format(platform, free, budget['min_free']))
+    if stack_exhausted:
+        problems.append('{}: stack use reached the end of the painted range'.format(platform))
+    return problems
+
+
+def main():
+    problems = []
+    reports = 0
+    for line in fileinput.input():
+        report = parse(line)
+        if report:
+            reports += 1
+            problems += check(*report)
+    if not reports:
+        print('No memstats reports found')
+        return 1
+    for problem in problems:
+        print(problem)
+    return 1 if problems else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())